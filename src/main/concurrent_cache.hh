@@ -0,0 +1,404 @@
+#ifndef CONCURRENT_CACHE_HH
+#define CONCURRENT_CACHE_HH
+
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "util.hh"
+
+/**
+ * A thread-safe variant of the Cache. The entries are distributed
+ * among a number of shards, each of which is guarded by its own
+ * lock. Each shard stores its entries in a flat, linearly probed
+ * hash table and evicts entries according to the CLOCK
+ * (second chance) scheme, which approximates LRU eviction.
+ *
+ * Values are computed outside of the locks, so concurrent misses
+ * on the same key may compute the same value more than once.
+ **/
+template<class Key,
+         class Value,
+         class Hash = std::hash<Key>>
+class ConcurrentCache
+{
+public:
+  typedef std::function<Value(const Key&)> Compute;
+
+private:
+  struct Slot
+  {
+    Key key;
+    Value value;
+    std::size_t hash;
+    bool occupied;
+    bool referenced;
+
+    Slot()
+      : hash(0),
+        occupied(false),
+        referenced(false)
+    {}
+  };
+
+  struct Shard
+  {
+    std::mutex mutex;
+    std::vector<Slot> slots;
+    idx size, capacity, hand;
+    std::size_t hits, misses;
+
+    Shard()
+      : size(0),
+        capacity(0),
+        hand(0),
+        hits(0),
+        misses(0)
+    {}
+
+    std::size_t mask() const
+    {
+      return slots.size() - 1;
+    }
+
+    Slot* find(const Key& key, std::size_t hash);
+    void insert(const Key& key, const Value& value, std::size_t hash);
+    void evict();
+    void erase(std::size_t position);
+  };
+
+  idx numShards;
+  std::unique_ptr<Shard[]> shards;
+  Compute func;
+
+  std::size_t hash(const Key& key) const
+  {
+    // Mix the bits, the hash functions of vertices are trivial
+    std::size_t value = Hash{}(key) * 0x9e3779b97f4a7c15ull;
+    return value ^ (value >> 32);
+  }
+
+  Shard& getShard(std::size_t hash) const
+  {
+    return shards[hash % numShards];
+  }
+
+public:
+  ConcurrentCache(const Compute& func,
+                  idx capacity = 100000,
+                  idx numShards = 16);
+
+  ConcurrentCache(const ConcurrentCache& other) = delete;
+
+  ConcurrentCache& operator=(const ConcurrentCache& other) = delete;
+
+  Value get(const Key& key);
+  bool contains(const Key& key) const;
+
+  /**
+   * Returns the cached value of the given key, if any, without
+   * computing it. The lookup counts as a hit or a miss.
+   **/
+  std::optional<Value> find(const Key& key);
+
+  void insert(const Key& key, const Value& value);
+
+  /**
+   * Returns the number of lookups which were answered
+   * by the cache.
+   **/
+  std::size_t getHits() const;
+
+  /**
+   * Returns the number of lookups which required
+   * a computation of the value.
+   **/
+  std::size_t getMisses() const;
+
+  idx size() const;
+};
+
+template<class Key,
+         class Value,
+         class Hash>
+ConcurrentCache<Key, Value, Hash>::ConcurrentCache(const Compute& func,
+                                                   idx capacity,
+                                                   idx numShards)
+  : numShards(std::max(numShards, (idx) 1)),
+    shards(new Shard[this->numShards]),
+    func(func)
+{
+  const idx shardCapacity = std::max((capacity + this->numShards - 1) / this->numShards,
+                                     (idx) 1);
+
+  // Keep the load factor of the tables at or below one half
+  std::size_t tableSize = 1;
+
+  while(tableSize < 2*((std::size_t) shardCapacity))
+  {
+    tableSize *= 2;
+  }
+
+  for(idx i = 0; i < this->numShards; ++i)
+  {
+    shards[i].capacity = shardCapacity;
+    shards[i].slots.resize(tableSize);
+  }
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+typename ConcurrentCache<Key, Value, Hash>::Slot*
+ConcurrentCache<Key, Value, Hash>::Shard::find(const Key& key, std::size_t hash)
+{
+  std::size_t position = (hash >> 8) & mask();
+
+  while(slots[position].occupied)
+  {
+    Slot& slot = slots[position];
+
+    if(slot.hash == hash and slot.key == key)
+    {
+      return &slot;
+    }
+
+    position = (position + 1) & mask();
+  }
+
+  return nullptr;
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+void ConcurrentCache<Key, Value, Hash>::Shard::insert(const Key& key,
+                                                      const Value& value,
+                                                      std::size_t hash)
+{
+  if(find(key, hash))
+  {
+    return;
+  }
+
+  // make space if necessary
+  if(size == capacity)
+  {
+    evict();
+  }
+
+  std::size_t position = (hash >> 8) & mask();
+
+  while(slots[position].occupied)
+  {
+    position = (position + 1) & mask();
+  }
+
+  Slot& slot = slots[position];
+
+  slot.key = key;
+  slot.value = value;
+  slot.hash = hash;
+  slot.occupied = true;
+  slot.referenced = false;
+
+  ++size;
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+void ConcurrentCache<Key, Value, Hash>::Shard::evict()
+{
+  assert(size > 0);
+
+  // advance the clock hand, giving referenced entries a second chance
+  while(true)
+  {
+    Slot& slot = slots[hand];
+
+    if(slot.occupied)
+    {
+      if(!slot.referenced)
+      {
+        erase(hand);
+        return;
+      }
+
+      slot.referenced = false;
+    }
+
+    hand = (hand + 1) & mask();
+  }
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+void ConcurrentCache<Key, Value, Hash>::Shard::erase(std::size_t position)
+{
+  // backward shift deletion, keeps the probe sequences intact
+  std::size_t next = position;
+
+  while(true)
+  {
+    next = (next + 1) & mask();
+
+    if(!slots[next].occupied)
+    {
+      break;
+    }
+
+    const std::size_t home = (slots[next].hash >> 8) & mask();
+
+    const bool movable = (position <= next)
+      ? (home <= position or home > next)
+      : (home <= position and home > next);
+
+    if(movable)
+    {
+      slots[position] = slots[next];
+      position = next;
+    }
+  }
+
+  slots[position].occupied = false;
+  slots[position].referenced = false;
+
+  --size;
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+bool ConcurrentCache<Key, Value, Hash>::contains(const Key& key) const
+{
+  const std::size_t keyHash = hash(key);
+  Shard& shard = getShard(keyHash);
+
+  std::lock_guard<std::mutex> guard(shard.mutex);
+
+  return shard.find(key, keyHash) != nullptr;
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+std::optional<Value> ConcurrentCache<Key, Value, Hash>::find(const Key& key)
+{
+  const std::size_t keyHash = hash(key);
+  Shard& shard = getShard(keyHash);
+
+  std::lock_guard<std::mutex> guard(shard.mutex);
+
+  Slot* slot = shard.find(key, keyHash);
+
+  if(!slot)
+  {
+    ++shard.misses;
+    return {};
+  }
+
+  ++shard.hits;
+  slot->referenced = true;
+  return slot->value;
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+Value ConcurrentCache<Key, Value, Hash>::get(const Key& key)
+{
+  const std::size_t keyHash = hash(key);
+  Shard& shard = getShard(keyHash);
+
+  {
+    std::lock_guard<std::mutex> guard(shard.mutex);
+
+    Slot* slot = shard.find(key, keyHash);
+
+    if(slot)
+    {
+      ++shard.hits;
+      slot->referenced = true;
+      return slot->value;
+    }
+
+    ++shard.misses;
+  }
+
+  Value value = func(key);
+
+  {
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    shard.insert(key, value, keyHash);
+  }
+
+  return value;
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+void ConcurrentCache<Key, Value, Hash>::insert(const Key& key, const Value& value)
+{
+  const std::size_t keyHash = hash(key);
+  Shard& shard = getShard(keyHash);
+
+  std::lock_guard<std::mutex> guard(shard.mutex);
+
+  shard.insert(key, value, keyHash);
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+std::size_t ConcurrentCache<Key, Value, Hash>::getHits() const
+{
+  std::size_t hits = 0;
+
+  for(idx i = 0; i < numShards; ++i)
+  {
+    std::lock_guard<std::mutex> guard(shards[i].mutex);
+    hits += shards[i].hits;
+  }
+
+  return hits;
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+std::size_t ConcurrentCache<Key, Value, Hash>::getMisses() const
+{
+  std::size_t misses = 0;
+
+  for(idx i = 0; i < numShards; ++i)
+  {
+    std::lock_guard<std::mutex> guard(shards[i].mutex);
+    misses += shards[i].misses;
+  }
+
+  return misses;
+}
+
+template<class Key,
+         class Value,
+         class Hash>
+idx ConcurrentCache<Key, Value, Hash>::size() const
+{
+  idx size = 0;
+
+  for(idx i = 0; i < numShards; ++i)
+  {
+    std::lock_guard<std::mutex> guard(shards[i].mutex);
+    size += shards[i].size;
+  }
+
+  return size;
+}
+
+#endif /* CONCURRENT_CACHE_HH */
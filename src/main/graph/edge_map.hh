@@ -151,6 +151,14 @@ public:
     std::fill(values.begin(), values.end(), value);
   }
 
+  /**
+   * The values of the map, indexed by the edges.
+   **/
+  const T* data() const
+  {
+    return values.data();
+  }
+
   const EdgeValueMap<T>& getValues() const
   {
     return valueMap;
@@ -2,12 +2,14 @@
 
 #include <cassert>
 #include <stack>
+#include <stdexcept>
 
 #include "subgraph.hh"
 #include "vertex_set.hh"
 
 Graph::Graph(idx size, const std::vector<Edge>& edges)
-  : size(size)
+  : size(size),
+    compacted(false)
 {
   for(idx i = 0; i < size; ++i)
   {
@@ -24,7 +26,8 @@ Graph::Graph(idx size, const std::vector<Edge>& edges)
 }
 
 Graph::Graph(idx size, std::initializer_list<std::pair<idx, idx>> edges)
-  : size(size)
+  : size(size),
+    compacted(false)
 {
   for(idx i = 0; i < size; ++i)
   {
@@ -39,8 +42,18 @@ Graph::Graph(idx size, std::initializer_list<std::pair<idx, idx>> edges)
   }
 }
 
+void Graph::ensureExtensible() const
+{
+  if(compacted)
+  {
+    throw std::logic_error("Graph has been compacted");
+  }
+}
+
 Vertex Graph::addVertex()
 {
+  ensureExtensible();
+
   Vertex vertex(size);
   outgoing.push_back({});
   incoming.push_back({});
@@ -50,6 +63,8 @@ Vertex Graph::addVertex()
 
 void Graph::addEdge(const Edge& edge)
 {
+  ensureExtensible();
+
   assert(edge.getIndex() == edges.size());
   assert(edge.getSource().getIndex() < size);
   assert(edge.getTarget().getIndex() < size);
@@ -70,22 +85,40 @@ Vertices Graph::getVertices() const
   return Vertices(size);
 }
 
-const std::vector<Edge>& Graph::getOutgoing(Vertex vertex) const
+void Graph::compact()
 {
-  return outgoing[vertex.getIndex()];
-}
+  if(compacted)
+  {
+    return;
+  }
 
-const std::vector<Edge>& Graph::getIncoming(Vertex vertex) const
-{
-  return incoming[vertex.getIndex()];
-}
+  outgoingOffsets.reserve(size + 1);
+  incomingOffsets.reserve(size + 1);
 
-const std::vector<Edge>& Graph::getEdges(Vertex vertex,
-                                         Direction direction) const
-{
-  return (direction == Direction::OUTGOING) ?
-    getOutgoing(vertex) :
-    getIncoming(vertex);
+  outgoingEdges.reserve(edges.size());
+  incomingEdges.reserve(edges.size());
+
+  for(idx i = 0; i < size; ++i)
+  {
+    outgoingOffsets.push_back(outgoingEdges.size());
+    incomingOffsets.push_back(incomingEdges.size());
+
+    outgoingEdges.insert(std::end(outgoingEdges),
+                         std::begin(outgoing[i]),
+                         std::end(outgoing[i]));
+
+    incomingEdges.insert(std::end(incomingEdges),
+                         std::begin(incoming[i]),
+                         std::end(incoming[i]));
+  }
+
+  outgoingOffsets.push_back(outgoingEdges.size());
+  incomingOffsets.push_back(incomingEdges.size());
+
+  outgoing = {};
+  incoming = {};
+
+  compacted = true;
 }
 
 bool Graph::contains(const Edge& edge) const
@@ -103,6 +136,8 @@ bool Graph::contains(const Edge& edge) const
 
 Edge Graph::addEdge(Vertex source, Vertex target)
 {
+  ensureExtensible();
+
   assert((size_t) source.getIndex() < getVertices().size());
   assert((size_t) target.getIndex() < getVertices().size());
 
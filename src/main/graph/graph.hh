@@ -5,12 +5,19 @@
 #include <vector>
 #include <queue>
 
+#include "span.hh"
+
 #include "edge.hh"
 #include "vertex.hh"
 #include "vertex_set.hh"
 
 class SubGraph;
 
+/**
+ * A contiguous, read-only range of Edge%s.
+ **/
+typedef Span<const Edge> EdgeSpan;
+
 /**
  * A class designed to iterate over the adjacent edges of a Vertex.
  *
@@ -23,11 +30,11 @@ class SubGraph;
 class AdjacentEdges
 {
 private:
-  const std::vector<Edge>& outgoing;
-  const std::vector<Edge>& incoming;
+  EdgeSpan outgoing;
+  EdgeSpan incoming;
 public:
-  AdjacentEdges(const std::vector<Edge>& outgoing,
-                const std::vector<Edge>& incoming)
+  AdjacentEdges(EdgeSpan outgoing,
+                EdgeSpan incoming)
     : outgoing(outgoing),
       incoming(incoming)
   {}
@@ -35,19 +42,19 @@ public:
   class Iterator
   {
   private:
-    const std::vector<Edge>& outgoing;
-    const std::vector<Edge>& incoming;
-    std::vector<Edge>::const_iterator iter;
+    EdgeSpan outgoing;
+    EdgeSpan incoming;
+    EdgeSpan::const_iterator iter;
   public:
-    Iterator(const std::vector<Edge>& outgoing,
-             const std::vector<Edge>& incoming,
-             const std::vector<Edge>::const_iterator& iter)
+    Iterator(EdgeSpan outgoing,
+             EdgeSpan incoming,
+             EdgeSpan::const_iterator iter)
       : outgoing(outgoing),
         incoming(incoming),
         iter(iter)
     {}
-    Iterator(const std::vector<Edge>& outgoing,
-             const std::vector<Edge>& incoming)
+    Iterator(EdgeSpan outgoing,
+             EdgeSpan incoming)
       : outgoing(outgoing),
         incoming(incoming),
         iter(outgoing.end())
@@ -169,7 +176,10 @@ public:
 
 /**
  * A class modelling a graph. Vertices are stored implicitely.
- * Outgoing / incoming Edge%s are stored in vectors.
+ * Outgoing / incoming Edge%s are stored in vectors. Once the
+ * construction is finished, the Graph can be compacted, storing
+ * the outgoing / incoming Edge%s contiguously (in compressed
+ * sparse row format).
  **/
 class Graph
 {
@@ -179,8 +189,14 @@ private:
 
   std::vector<std::vector<Edge>> outgoing, incoming;
 
+  bool compacted;
+  std::vector<idx> outgoingOffsets, incomingOffsets;
+  std::vector<Edge> outgoingEdges, incomingEdges;
+
   bool check() const;
 
+  void ensureExtensible() const;
+
   void addEdge(const Edge& edge);
 
 public:
@@ -193,7 +209,8 @@ public:
   Graph(idx size, const std::vector<Edge>& edges);
   Graph()
     : size(0),
-      edges({})
+      edges({}),
+      compacted(false)
   {}
 
   Vertex addVertex();
@@ -214,19 +231,63 @@ public:
   /**
    * Returns the outgoing Edge%s of the given Vertex.
    **/
-  const std::vector<Edge>& getOutgoing(Vertex vertex) const;
+  EdgeSpan getOutgoing(Vertex vertex) const
+  {
+    assert(vertex.getIndex() < size);
+
+    if(compacted)
+    {
+      const idx offset = outgoingOffsets[vertex.getIndex()];
+      return EdgeSpan(outgoingEdges.data() + offset,
+                      outgoingOffsets[vertex.getIndex() + 1] - offset);
+    }
+
+    return EdgeSpan(outgoing[vertex.getIndex()]);
+  }
 
   /**
    * Returns the incoming Edge%s of the given Vertex.
    **/
-  const std::vector<Edge>& getIncoming(Vertex vertex) const;
+  EdgeSpan getIncoming(Vertex vertex) const
+  {
+    assert(vertex.getIndex() < size);
+
+    if(compacted)
+    {
+      const idx offset = incomingOffsets[vertex.getIndex()];
+      return EdgeSpan(incomingEdges.data() + offset,
+                      incomingOffsets[vertex.getIndex() + 1] - offset);
+    }
+
+    return EdgeSpan(incoming[vertex.getIndex()]);
+  }
 
   /**
    * Returns the all Edge%s incident to the given Vertex with
    * respect to a given Direction.
    **/
-  const std::vector<Edge>& getEdges(Vertex vertex,
-                                    Direction direction) const;
+  EdgeSpan getEdges(Vertex vertex,
+                    Direction direction) const
+  {
+    return (direction == Direction::OUTGOING) ?
+      getOutgoing(vertex) :
+      getIncoming(vertex);
+  }
+
+  /**
+   * Stores the outgoing / incoming Edge%s of all vertices
+   * contiguously. Afterwards, no vertices or Edge%s can
+   * be added to the Graph.
+   **/
+  void compact();
+
+  /**
+   * Returns whether the Graph has been compacted.
+   **/
+  bool isCompact() const
+  {
+    return compacted;
+  }
 
   /**
    * Returns an iterator over the Edge%s which are incident to
@@ -0,0 +1,328 @@
+#ifndef PARALLEL_HH
+#define PARALLEL_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "util.hh"
+
+/**
+ * Returns the number of threads used by default
+ * for parallel computations.
+ **/
+inline idx defaultNumThreads()
+{
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/**
+ * Calls the given function for all indices in [0, size) using
+ * the given number of threads. The indices are distributed
+ * dynamically among the threads. If any of the calls throws,
+ * the first exception is rethrown after all threads have finished.
+ *
+ * @tparam Func A function which can be called with an index
+ **/
+template<class Func>
+void parallelFor(idx size, Func func, idx numThreads = defaultNumThreads())
+{
+  numThreads = std::min(numThreads, size);
+
+  if(numThreads <= 1)
+  {
+    for(idx i = 0; i < size; ++i)
+    {
+      func(i);
+    }
+
+    return;
+  }
+
+  std::atomic<idx> next(0);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+
+  auto work = [&]()
+    {
+      try
+      {
+        for(idx i = next++; i < size; i = next++)
+        {
+          func(i);
+        }
+      }
+      catch(...)
+      {
+        std::lock_guard<std::mutex> guard(errorMutex);
+
+        if(!error)
+        {
+          error = std::current_exception();
+        }
+
+        next = size;
+      }
+    };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads - 1);
+
+  for(idx i = 0; i < numThreads - 1; ++i)
+  {
+    threads.push_back(std::thread(work));
+  }
+
+  work();
+
+  for(std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  if(error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * A fixed set of threads which is reused across parallel loops,
+ * avoiding to spawn and join threads for every loop. The calling
+ * thread takes part in each loop, so a pool of the given number of
+ * threads starts one thread less. Loops must not be run concurrently
+ * or recursively on the same pool.
+ **/
+class ThreadPool
+{
+private:
+  std::vector<std::thread> workers;
+
+  std::mutex mutex;
+  std::condition_variable started;
+  std::condition_variable finished;
+
+  const std::function<void(idx)>* task = nullptr;
+  idx size = 0;
+  std::atomic<idx> next{0};
+  std::exception_ptr error;
+
+  idx generation = 0;
+  idx pending = 0;
+  bool stopped = false;
+
+  void work()
+  {
+    try
+    {
+      for(idx i = next++; i < size; i = next++)
+      {
+        (*task)(i);
+      }
+    }
+    catch(...)
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+
+      if(!error)
+      {
+        error = std::current_exception();
+      }
+
+      next = size;
+    }
+  }
+
+  void loop()
+  {
+    idx seen = 0;
+
+    while(true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        started.wait(lock, [&]() { return stopped or generation != seen; });
+
+        if(stopped)
+        {
+          return;
+        }
+
+        seen = generation;
+      }
+
+      work();
+
+      std::lock_guard<std::mutex> guard(mutex);
+
+      if(--pending == 0)
+      {
+        finished.notify_one();
+      }
+    }
+  }
+
+public:
+  explicit ThreadPool(idx numThreads = defaultNumThreads())
+  {
+    for(idx i = 1; i < numThreads; ++i)
+    {
+      workers.push_back(std::thread([this]() { loop(); }));
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      stopped = true;
+    }
+
+    started.notify_all();
+
+    for(std::thread& worker : workers)
+    {
+      worker.join();
+    }
+  }
+
+  idx numThreads() const
+  {
+    return workers.size() + 1;
+  }
+
+  /**
+   * Returns the index of the calling thread in [0, numThreads()),
+   * where the thread owning the pool has index zero. Loops can use
+   * the index to reuse one buffer per thread.
+   **/
+  idx threadIndex() const
+  {
+    const std::thread::id id = std::this_thread::get_id();
+
+    for(idx i = 0; i < workers.size(); ++i)
+    {
+      if(workers[i].get_id() == id)
+      {
+        return i + 1;
+      }
+    }
+
+    return 0;
+  }
+
+  /**
+   * Calls the given function for all indices in [0, size) as
+   * parallelFor() does, using the threads of this pool.
+   **/
+  void run(idx numIndices, const std::function<void(idx)>& func)
+  {
+    if(workers.empty() or numIndices <= 1)
+    {
+      for(idx i = 0; i < numIndices; ++i)
+      {
+        func(i);
+      }
+
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+
+      task = &func;
+      size = numIndices;
+      next = 0;
+      error = nullptr;
+      pending = workers.size();
+      ++generation;
+    }
+
+    started.notify_all();
+
+    work();
+
+    std::exception_ptr currentError;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      finished.wait(lock, [&]() { return pending == 0; });
+
+      task = nullptr;
+      std::swap(currentError, error);
+    }
+
+    if(currentError)
+    {
+      std::rethrow_exception(currentError);
+    }
+  }
+};
+
+/**
+ * Calls the given function for all indices in [0, size)
+ * using the threads of the given pool.
+ **/
+template<class Func>
+void parallelFor(ThreadPool& pool, idx size, Func func)
+{
+  pool.run(size, std::function<void(idx)>(std::ref(func)));
+}
+
+/**
+ * Returns the smallest index in [0, size) satisfying the given
+ * predicate, or size if there is none. The predicate is evaluated
+ * in parallel using the given number of threads, indices above
+ * an index already known to satisfy the predicate are skipped.
+ * The predicate is passed the smallest such index found so far
+ * and may give up early (returning false) once it drops below its
+ * own index. The result does not depend on the number of threads.
+ *
+ * @tparam Pred A function which can be called with an index and
+ *              a const std::atomic<idx>&
+ **/
+template<class Pred>
+idx parallelFindFirst(ThreadPool& pool, idx size, Pred pred)
+{
+  std::atomic<idx> found(size);
+
+  parallelFor(pool,
+              size,
+              [&](idx index)
+              {
+                if(found < index or !pred(index, found))
+                {
+                  return;
+                }
+
+                idx current = found;
+
+                while(index < current and
+                      !found.compare_exchange_weak(current, index))
+                {}
+              });
+
+  return found;
+}
+
+/**
+ * As above, using the given number of threads.
+ **/
+template<class Pred>
+idx parallelFindFirst(idx size, Pred pred, idx numThreads = defaultNumThreads())
+{
+  ThreadPool pool(std::min(numThreads, size));
+
+  return parallelFindFirst(pool, size, pred);
+}
+
+#endif /* PARALLEL_HH */
@@ -6,6 +6,7 @@
 #include <objscip/objscip.h>
 #include <scip/scip.h>
 
+#include "parallel.hh"
 #include "solution_stats.hh"
 
 class LPObserver;
@@ -19,12 +20,16 @@ public:
     bool collect;
     std::string setFile;
     bool solveRelaxation;
+    std::string graphCacheFile;
+    idx numThreads;
 
     Settings()
       : solverOutput(true),
         collect(false),
         setFile(""),
-        solveRelaxation(false)
+        solveRelaxation(false),
+        graphCacheFile(""),
+        numThreads(defaultNumThreads())
     {}
 
     Settings& withSetFile(const std::string& file)
@@ -51,6 +56,27 @@ public:
       return *this;
     }
 
+    /**
+     * Reads the time-expanded graph of the program from the given
+     * file if it exists, writing it to the file otherwise,
+     * see createCachedTimeExpandedGraph().
+     **/
+    Settings& withGraphCache(const std::string& file)
+    {
+      graphCacheFile = file;
+      return *this;
+    }
+
+    /**
+     * The number of threads used within the program, i.e., to expand
+     * the time-expanded graph and to price concurrently.
+     **/
+    Settings& withThreads(idx threads)
+    {
+      numThreads = std::max(threads, (idx) 1);
+      return *this;
+    }
+
   };
 
 private:
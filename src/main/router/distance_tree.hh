@@ -2,6 +2,7 @@
 #define DISTANCE_TREE_HH
 
 #include <stdexcept>
+#include <type_traits>
 
 #include "graph/graph.hh"
 #include "graph/edge_map.hh"
@@ -17,9 +18,17 @@ private:
   const Graph& graph;
   const EdgeFunc<T>& costs;
 
-  LabelHeap<SimpleLabel<T>> heap;
+  // integral distances are settled using a radix heap
+  typedef std::conditional_t<std::is_integral<T>::value,
+                             RadixLabelHeap<SimpleLabel<T>>,
+                             LabelHeap<SimpleLabel<T>>> Heap;
+
+  Heap heap;
   T maxDist;
 
+  // the distance of the most recently explored vertex
+  T lastDist;
+
   template<class Predicate, class Filter = AllEdgeFilter>
   void extendWhile(Predicate predicate, Filter filter = Filter());
 
@@ -53,6 +62,11 @@ public:
 
   T distance(Vertex vertex) const;
 
+  /**
+   * Adds a root with the given distance. Vertices are explored
+   * in the order of their distances, so the distance must not
+   * be smaller than that of the most recently explored vertex.
+   **/
   void add(Vertex vertex, T distance = 0);
 
   bool done() const
@@ -73,7 +87,8 @@ DistanceTree<direction, T>::DistanceTree(const Graph& graph,
   : graph(graph),
     costs(costs),
     heap(graph),
-    maxDist(0)
+    maxDist(0),
+    lastDist(0)
 {
 }
 
@@ -84,7 +99,8 @@ DistanceTree<direction, T>::DistanceTree(const Graph& graph,
   : graph(graph),
     costs(costs),
     heap(graph),
-    maxDist(0)
+    maxDist(0),
+    lastDist(0)
 {
   add(root);
 }
@@ -97,7 +113,9 @@ DistanceTree<direction, T>::DistanceTree(const Graph& graph,
                                          It end)
   : graph(graph),
     costs(costs),
-    heap(graph)
+    heap(graph),
+    maxDist(0),
+    lastDist(0)
 {
   for(auto it = begin; it != end; ++it)
   {
@@ -124,6 +142,7 @@ Vertex DistanceTree<direction, T>::next(Filter filter)
   const SimpleLabel<T>& current = heap.extractMin();
 
   maxDist = std::max(maxDist, current.getCost());
+  lastDist = current.getCost();
 
   for(const Edge& edge : graph.getEdges(current.getVertex(), direction))
   {
@@ -190,6 +209,11 @@ void DistanceTree<direction, T>::add(Vertex vertex, T distance)
     throw std::invalid_argument("Vertex has already been explored");
   }
 
+  if(distance < lastDist)
+  {
+    throw std::invalid_argument("Distance is smaller than that of the last explored vertex");
+  }
+
   maxDist = std::max(maxDist, distance);
 
   return heap.update(SimpleLabel<T>(vertex, distance));
@@ -6,24 +6,72 @@
 #include "graph/graph.hh"
 #include "graph/vertex_map.hh"
 
+#include "radix_label_queue.hh"
+
 template <class T>
 using SimpleHeap = boost::heap::d_ary_heap<T,
                                            boost::heap::mutable_<true>,
                                            boost::heap::compare<std::greater<T>>,
                                            boost::heap::arity<2>>;
 
+/**
+ * A priority queue of Label%s based on a binary heap
+ * with mutable handles.
+ **/
 template <class Label>
-class LabelHeap
+class BinaryLabelQueue
 {
-public:
-  typedef SimpleHeap<Label> Heap;
 private:
+  typedef SimpleHeap<Label> Heap;
   typedef typename Heap::handle_type Handle;
 
-  const Graph& graph;
-  VertexMap<Label> labels;
   VertexMap<Handle> handles;
   Heap heap;
+
+public:
+  BinaryLabelQueue(const Graph& graph)
+    : handles(graph, Handle())
+  {}
+
+  void push(const Label& label)
+  {
+    handles(label.getVertex()) = heap.push(label);
+  }
+
+  void decrease(const Label& label)
+  {
+    heap.update(handles(label.getVertex()), label);
+  }
+
+  Vertex top()
+  {
+    return heap.top().getVertex();
+  }
+
+  void pop()
+  {
+    heap.pop();
+  }
+
+  bool empty() const
+  {
+    return heap.empty();
+  }
+};
+
+/**
+ * A heap of Label%s, storing one Label per Vertex.
+ *
+ * @tparam Queue The priority queue used to order the labeled vertices,
+ *               e.g., a RadixLabelQueue for integral, non-negative costs
+ **/
+template <class Label, class Queue = BinaryLabelQueue<Label>>
+class LabelHeap
+{
+private:
+  const Graph& graph;
+  VertexMap<Label> labels;
+  Queue queue;
 public:
   LabelHeap(const Graph& graph);
 
@@ -39,28 +87,35 @@ public:
   bool isEmpty() const;
 };
 
+/**
+ * A LabelHeap for Dijkstra's algorithm with integral,
+ * non-negative costs.
+ **/
 template <class Label>
-LabelHeap<Label>::LabelHeap(const Graph& graph)
+using RadixLabelHeap = LabelHeap<Label, RadixLabelQueue<Label>>;
+
+template <class Label, class Queue>
+LabelHeap<Label, Queue>::LabelHeap(const Graph& graph)
   : graph(graph),
     labels(graph, Label()),
-    handles(graph, Handle())
+    queue(graph)
 {
 }
 
-template <class Label>
-const Label& LabelHeap<Label>::getLabel(Vertex vertex) const
+template <class Label, class Queue>
+const Label& LabelHeap<Label, Queue>::getLabel(Vertex vertex) const
 {
   return labels(vertex);
 }
 
-template <class Label>
-Label& LabelHeap<Label>::getLabel(Vertex vertex)
+template <class Label, class Queue>
+Label& LabelHeap<Label, Queue>::getLabel(Vertex vertex)
 {
   return labels(vertex);
 }
 
-template <class Label>
-void LabelHeap<Label>::update(Label label)
+template <class Label, class Queue>
+void LabelHeap<Label, Queue>::update(Label label)
 {
   Label& current = getLabel(label.getVertex());
 
@@ -69,15 +124,14 @@ void LabelHeap<Label>::update(Label label)
   case State::UNKNOWN:
     current = label;
     current.setState(State::LABELED);
-    handles(current.getVertex()) = heap.push(current);
+    queue.push(current);
     break;
   case State::SETTLED:
     return;
   case State::LABELED:
     if(current > label)
     {
-      Handle handle = handles(current.getVertex());
-      heap.update(handle, label);
+      queue.decrease(label);
       current = label;
     }
     return;
@@ -85,30 +139,28 @@ void LabelHeap<Label>::update(Label label)
 
 }
 
-template <class Label>
-const Label& LabelHeap<Label>::extractMin()
+template <class Label, class Queue>
+const Label& LabelHeap<Label, Queue>::extractMin()
 {
   assert(!isEmpty());
-  const Label minLabel = heap.top();
-  heap.pop();
-  Label& label = getLabel(minLabel.getVertex());
+  const Vertex vertex = queue.top();
+  queue.pop();
+  Label& label = getLabel(vertex);
 
   label.setState(State::SETTLED);
 
   return label;
 }
 
-template <class Label>
-const Label& LabelHeap<Label>::peek()
+template <class Label, class Queue>
+const Label& LabelHeap<Label, Queue>::peek()
 {
   assert(!isEmpty());
-  const Label& minLabel = heap.top();
-  Label& label = getLabel(minLabel.getVertex());
-  return label;
+  return getLabel(queue.top());
 }
 
-template <class Label>
-bool LabelHeap<Label>::finished() const
+template <class Label, class Queue>
+bool LabelHeap<Label, Queue>::finished() const
 {
   for(const Vertex& vertex : graph.getVertices())
   {
@@ -121,10 +173,10 @@ bool LabelHeap<Label>::finished() const
   return true;
 }
 
-template <class Label>
-bool LabelHeap<Label>::isEmpty() const
+template <class Label, class Queue>
+bool LabelHeap<Label, Queue>::isEmpty() const
 {
-  return heap.empty();
+  return queue.empty();
 }
 
 #endif /* LABEL_HEAP_HH */
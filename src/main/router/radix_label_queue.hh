@@ -0,0 +1,207 @@
+#ifndef RADIX_LABEL_QUEUE_HH
+#define RADIX_LABEL_QUEUE_HH
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "graph/graph.hh"
+#include "graph/vertex_map.hh"
+#include "graph/vertex_set.hh"
+
+/**
+ * A monotone priority queue of Label%s with integral costs based
+ * on a radix heap. Entries are distributed among buckets according
+ * to the most significant bit in which their keys differ from the
+ * last extracted key. Insertions and decreases take constant time,
+ * each entry is moved to a lower bucket at most once per bit.
+ *
+ * The queue is monotone, i.e., the costs of inserted labels must not
+ * be smaller than the cost of the last extracted label, which is
+ * the case for Dijkstra's algorithm with non-negative costs.
+ * Decreased labels are inserted again, outdated entries are
+ * skipped upon extraction.
+ **/
+template <class Label>
+class RadixLabelQueue
+{
+private:
+  typedef uint64_t Key;
+
+  struct Entry
+  {
+    Key key;
+    Vertex vertex;
+  };
+
+  static const idx numBuckets = std::numeric_limits<Key>::digits + 1;
+
+  std::array<std::vector<Entry>, numBuckets> buckets;
+  VertexMap<Key> keys;
+  VertexSet queued;
+  Key last;
+  idx numQueued;
+
+  template <class T>
+  static Key getKey(T cost)
+  {
+    static_assert(std::is_integral<T>::value,
+                  "Radix queues require integral costs");
+
+    // order-preserving mapping of signed values
+    if(std::is_signed<T>::value)
+    {
+      return ((Key) (int64_t) cost) ^ (((Key) 1) << (numBuckets - 2));
+    }
+
+    return (Key) cost;
+  }
+
+  static idx getBucket(Key key, Key last)
+  {
+    return (key == last) ? 0 : numBuckets - 1 - __builtin_clzll(key ^ last);
+  }
+
+  bool isStale(const Entry& entry) const
+  {
+    return !queued.contains(entry.vertex) or keys(entry.vertex) != entry.key;
+  }
+
+  void insert(Key key, Vertex vertex);
+
+  void refill();
+
+public:
+  RadixLabelQueue(const Graph& graph)
+    : keys(graph, 0),
+      queued(graph),
+      last(0),
+      numQueued(0)
+  {}
+
+  void push(const Label& label);
+
+  void decrease(const Label& label);
+
+  Vertex top();
+
+  void pop();
+
+  bool empty() const
+  {
+    return numQueued == 0;
+  }
+};
+
+template <class Label>
+void RadixLabelQueue<Label>::insert(Key key, Vertex vertex)
+{
+  if(key < last)
+  {
+    throw std::invalid_argument("Cost is smaller than the last extracted cost");
+  }
+
+  keys(vertex) = key;
+  buckets[getBucket(key, last)].push_back(Entry{key, vertex});
+}
+
+template <class Label>
+void RadixLabelQueue<Label>::push(const Label& label)
+{
+  assert(!queued.contains(label.getVertex()));
+
+  insert(getKey(label.getCost()), label.getVertex());
+  queued.insert(label.getVertex());
+  ++numQueued;
+}
+
+template <class Label>
+void RadixLabelQueue<Label>::decrease(const Label& label)
+{
+  assert(queued.contains(label.getVertex()));
+
+  insert(getKey(label.getCost()), label.getVertex());
+}
+
+template <class Label>
+void RadixLabelQueue<Label>::refill()
+{
+  assert(!empty());
+
+  idx i = 1;
+
+  while(buckets[0].empty())
+  {
+    assert(i < numBuckets);
+
+    std::vector<Entry>& bucket = buckets[i++];
+
+    if(bucket.empty())
+    {
+      continue;
+    }
+
+    bool found = false;
+    Key minKey = 0;
+
+    for(const Entry& entry : bucket)
+    {
+      if(!isStale(entry) and (!found or entry.key < minKey))
+      {
+        minKey = entry.key;
+        found = true;
+      }
+    }
+
+    if(found)
+    {
+      // all remaining keys in the bucket agree with the new minimum
+      // in more bits than with the last one, so they move to lower buckets
+      last = minKey;
+
+      for(const Entry& entry : bucket)
+      {
+        if(!isStale(entry))
+        {
+          buckets[getBucket(entry.key, last)].push_back(entry);
+        }
+      }
+    }
+
+    bucket.clear();
+  }
+}
+
+template <class Label>
+Vertex RadixLabelQueue<Label>::top()
+{
+  while(true)
+  {
+    refill();
+
+    std::vector<Entry>& bucket = buckets[0];
+
+    if(isStale(bucket.back()))
+    {
+      bucket.pop_back();
+      continue;
+    }
+
+    return bucket.back().vertex;
+  }
+}
+
+template <class Label>
+void RadixLabelQueue<Label>::pop()
+{
+  const Vertex vertex = top();
+
+  buckets[0].pop_back();
+  queued.remove(vertex);
+  --numQueued;
+}
+
+#endif /* RADIX_LABEL_QUEUE_HH */
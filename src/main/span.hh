@@ -0,0 +1,69 @@
+#ifndef SPAN_HH
+#define SPAN_HH
+
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+#include "util.hh"
+
+/**
+ * A contiguous range of values which is not owned by the span.
+ * Spans over const values are read-only.
+ **/
+template <class T>
+class Span
+{
+private:
+  typedef std::remove_const_t<T> Value;
+
+  T* first;
+  idx length;
+
+public:
+  typedef T* iterator;
+  typedef T* const_iterator;
+
+  Span(T* first, idx length)
+    : first(first),
+      length(length)
+  {}
+
+  Span(std::vector<Value>& values)
+    : first(values.data()),
+      length(values.size())
+  {}
+
+  Span(const std::vector<Value>& values)
+    : first(values.data()),
+      length(values.size())
+  {}
+
+  iterator begin() const
+  {
+    return first;
+  }
+
+  iterator end() const
+  {
+    return first + length;
+  }
+
+  idx size() const
+  {
+    return length;
+  }
+
+  bool empty() const
+  {
+    return length == 0;
+  }
+
+  T& operator[](idx index) const
+  {
+    assert(index < length);
+    return first[index];
+  }
+};
+
+#endif /* SPAN_HH */
@@ -6,7 +6,10 @@ void AugmentedEdgeFunc::generateCosts(const Edge& edge,
                                       num scaleFactor,
                                       const ValueVector& times)
 {
-  timedCosts(edge).reserve(timeHorizon);
+  if(times.empty() or times.back() != (num) timeHorizon)
+  {
+    throw std::invalid_argument("Break times must end at the time horizon");
+  }
 
   num currentCost = 0;
   num factor = 1;
@@ -38,8 +41,7 @@ void AugmentedEdgeFunc::generateCosts(const Edge& edge,
     factor *= -1;
   }
 
-  ;
-
+  timedCosts(edge).shrink_to_fit();
 }
 
 void AugmentedEdgeFunc::generateCosts(const EdgeFunc<num>& costs,
@@ -51,5 +53,4 @@ void AugmentedEdgeFunc::generateCosts(const EdgeFunc<num>& costs,
   {
     generateCosts(edge, costs(edge), timeHorizon, scaleFactor, times(edge));
   }
-
 }
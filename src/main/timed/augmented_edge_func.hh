@@ -2,14 +2,23 @@
 #define AUGMENTED_EDGE_FUNC_H
 
 #include <map>
+#include <stdexcept>
 
 #include "timed_edge_func.hh"
-
+#include "piecewise_linear_func.hh"
+
+/**
+ * A time-dependent cost function whose travel times alternately
+ * increase and decrease between a set of breaks. The travel times
+ * of each Edge are stored as a PiecewiseLinearFunc, i.e., the
+ * memory consumption is proportional to the number of breaks
+ * rather than to the time horizon.
+ **/
 class AugmentedEdgeFunc : public TimedEdgeFunc<num>
 {
 private:
   const Graph& graph;
-  EdgeMap<ValueVector> timedCosts;
+  EdgeMap<PiecewiseLinearFunc> timedCosts;
   num scaleFactor;
 
   void generateCosts(const EdgeFunc<num>& costs,
@@ -17,6 +26,10 @@ private:
                      num scaleFactor,
                      const EdgeFunc<ValueVector>& times);
 
+  /**
+   * Generates the travel times of the given Edge up to the time horizon.
+   * The last break must coincide with the time horizon.
+   **/
   void generateCosts(const Edge& edge,
                      num cost,
                      idx timeHorizon,
@@ -30,7 +43,7 @@ public:
                     num scaleFactor,
                     const EdgeFunc<ValueVector>& times)
     : graph(graph),
-      timedCosts(graph, ValueVector{}),
+      timedCosts(graph, PiecewiseLinearFunc()),
       scaleFactor(scaleFactor)
   {
     assert(scaleFactor >= 1);
@@ -38,14 +51,27 @@ public:
     generateCosts(costs, timeHorizon, scaleFactor, times);
   }
 
-  num operator()(const Edge& edge, idx currentTime) const override
+  num operator()(const Edge& edge, idx currentTime) const override final
   {
+    const PiecewiseLinearFunc& func = timedCosts(edge);
+
     if(debuggingEnabled())
     {
-      return timedCosts(edge).at(currentTime);
+      if(currentTime >= func.getHorizon())
+      {
+        throw std::out_of_range("Time exceeds the time horizon");
+      }
     }
 
-    return timedCosts(edge)[currentTime];
+    return func(currentTime);
+  }
+
+  /**
+   * Returns the piecewise linear travel times of the given Edge.
+   **/
+  const PiecewiseLinearFunc& getFunc(const Edge& edge) const
+  {
+    return timedCosts(edge);
   }
 
   template <class Generator>
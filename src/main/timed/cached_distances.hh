@@ -7,7 +7,7 @@
 #include "timed_vertex_func.hh"
 #include "timed_router.hh"
 
-#include "cache.hh"
+#include "concurrent_cache.hh"
 #include "util.hh"
 
 class CachedDistances : public TimedDistanceFunc
@@ -43,7 +43,7 @@ private:
 
   TimedRouter& router;
   TimedEdgeFunc<num>& costs;
-  Cache<Entry, num, EntryHasher> cache;
+  ConcurrentCache<Entry, num, EntryHasher> cache;
 
   num shortestPath(const Entry& entry);
 
@@ -57,6 +57,16 @@ public:
   {}
 
   num operator()(const Vertex& vertex, const Vertex& target, idx departureTime) override;
+
+  std::size_t getHits() const
+  {
+    return cache.getHits();
+  }
+
+  std::size_t getMisses() const
+  {
+    return cache.getMisses();
+  }
 };
 
 #endif /* CACHED_DISTANCES_HH */
@@ -1,8 +1,5 @@
 #include "cached_tree_distances.hh"
 
-#include "router/label.hh"
-#include "router/label_heap.hh"
-
 num CachedTreeDistances::operator()(const Vertex& source,
                                     const Vertex& target,
                                     idx departureTime)
@@ -10,55 +7,28 @@ num CachedTreeDistances::operator()(const Vertex& source,
   return cache.get(Entry{source, target, departureTime});
 }
 
-num CachedTreeDistances::shortestPath(const Entry& entry)
+void CachedTreeDistances::distances(const Vertex& source,
+                                    idx departureTime,
+                                    Span<const Vertex> targets,
+                                    Span<num> values)
 {
-  const Vertex& source = entry.source;
-  const Vertex& target = entry.target;
-  const idx departureTime = entry.departureTime;
-
-  LabelHeap<Label<>> heap(graph);
-  int settled = 0, labeled = 0;
-  bool found = false;
-
-  heap.update(Label<>(source, Edge(), departureTime));
-
-  while(!heap.isEmpty())
+  if(targets.size() != values.size())
   {
-    const Label<>& current = heap.extractMin();
-
-    ++settled;
-
-    if(current.getVertex() == target)
-    {
-      found = true;
-      break;
-    }
-
-    for(const Edge& edge : graph.getOutgoing(current.getVertex()))
-    {
-      ++labeled;
-
-      Label<> nextLabel = Label<>(edge.getTarget(),
-                                  edge, current.getCost() + costs(edge, current.getCost()));
-
-      heap.update(nextLabel);
-    }
+    throw std::invalid_argument("Numbers of targets and values differ");
   }
 
-  for(const Vertex& vertex : vertices)
+  // Answer the row from the cache, searching once
+  // all targets on the first miss
+  for(idx i = 0; i < targets.size(); ++i)
   {
-    Label<> vertexLabel = heap.getLabel(vertex);
-    if(vertexLabel.getState() == State::SETTLED)
+    const std::optional<num> value = cache.find(Entry{source, targets[i], departureTime});
+
+    if(!value)
     {
-      cache.insert(Entry{source, vertex, departureTime}, vertexLabel.getCost() - departureTime);
+      search(source, departureTime, targets, values);
+      return;
     }
-  }
 
-  if(!found)
-  {
-    throw std::invalid_argument("Graph is not strongly connected");
+    values[i] = *value;
   }
-
-  Label<> targetLabel = heap.getLabel(target);
-  return targetLabel.getCost() - departureTime;
 }
@@ -1,6 +1,7 @@
 #ifndef CACHED_TREE_DISTANCES_HH
 #define CACHED_TREE_DISTANCES_HH
 
+#include <functional>
 #include <list>
 #include <unordered_map>
 #include <vector>
@@ -8,7 +9,11 @@
 #include "timed_vertex_func.hh"
 #include "timed_router.hh"
 
-#include "cache.hh"
+#include "router/label.hh"
+#include "router/label_heap.hh"
+
+#include "concurrent_cache.hh"
+#include "span.hh"
 #include "util.hh"
 
 class CachedTreeDistances : public TimedDistanceFunc
@@ -42,25 +47,158 @@ private:
     }
   };
 
+  typedef std::function<void(const Vertex&,
+                             idx,
+                             Span<const Vertex>,
+                             Span<num>)> Search;
+
   const Graph& graph;
   std::vector<Vertex> vertices;
-  TimedEdgeFunc<num>& costs;
-  Cache<Entry, num, EntryHasher> cache;
+  Search search;
+  ConcurrentCache<Entry, num, EntryHasher> cache;
 
-  num shortestPath(const Entry& entry);
+  /**
+   * Grows a shortest path tree from the given source until all of
+   * the given targets are settled, caching the distances to all
+   * settled vertices.
+   **/
+  template <class Costs>
+  void searchTree(const Vertex& source,
+                  idx departureTime,
+                  Span<const Vertex> targets,
+                  Span<num> values,
+                  const Costs& costs);
 
 public:
+  /**
+   * Creates distances with respect to the given costs. The searches
+   * are instantiated for the static type of the costs, passing
+   * a concrete cost function (such as an AugmentedEdgeFunc)
+   * avoids virtual calls inside the searches. The costs are
+   * referenced rather than copied and must outlive the distances.
+   **/
+  template <class Costs>
   CachedTreeDistances(const Graph& graph,
                       const std::vector<Vertex>& vertices,
-                      TimedEdgeFunc<num>& costs,
+                      const Costs& costs,
                       idx capacity = 100000)
     : graph(graph),
       vertices(vertices),
-      costs(costs),
-      cache(std::bind(&CachedTreeDistances::shortestPath, this, std::placeholders::_1), capacity)
+      search([this, &costs](const Vertex& source,
+                            idx departureTime,
+                            Span<const Vertex> targets,
+                            Span<num> values)
+             {
+               searchTree(source, departureTime, targets, values, costs);
+             }),
+      cache([this](const Entry& entry)
+            {
+              num value;
+
+              search(entry.source,
+                     entry.departureTime,
+                     Span<const Vertex>(&entry.target, 1),
+                     Span<num>(&value, 1));
+
+              return value;
+            },
+            capacity)
   {}
 
+  template <class Costs>
+  CachedTreeDistances(const Graph& graph,
+                      const std::vector<Vertex>& vertices,
+                      const Costs&& costs,
+                      idx capacity = 100000) = delete;
+
   num operator()(const Vertex& vertex, const Vertex& target, idx departureTime) override;
+
+  /**
+   * Answers the queries from the cache if all of them are contained,
+   * otherwise from a single tree search.
+   **/
+  void distances(const Vertex& source,
+                 idx departureTime,
+                 Span<const Vertex> targets,
+                 Span<num> values) override;
+
+  std::size_t getHits() const
+  {
+    return cache.getHits();
+  }
+
+  std::size_t getMisses() const
+  {
+    return cache.getMisses();
+  }
 };
 
+template <class Costs>
+void CachedTreeDistances::searchTree(const Vertex& source,
+                                     idx departureTime,
+                                     Span<const Vertex> targets,
+                                     Span<num> values,
+                                     const Costs& costs)
+{
+  assert(targets.size() == values.size());
+
+  RadixLabelHeap<Label<>> heap(graph);
+
+  VertexSet pending(graph);
+  idx numPending = 0;
+
+  for(const Vertex& target : targets)
+  {
+    if(!pending.contains(target))
+    {
+      pending.insert(target);
+      ++numPending;
+    }
+  }
+
+  heap.update(Label<>(source, Edge(), departureTime));
+
+  while(!heap.isEmpty() and numPending > 0)
+  {
+    const Label<>& current = heap.extractMin();
+
+    if(pending.contains(current.getVertex()))
+    {
+      pending.remove(current.getVertex());
+
+      if(--numPending == 0)
+      {
+        break;
+      }
+    }
+
+    for(const Edge& edge : graph.getOutgoing(current.getVertex()))
+    {
+      Label<> nextLabel = Label<>(edge.getTarget(),
+                                  edge, current.getCost() + costs(edge, current.getCost()));
+
+      heap.update(nextLabel);
+    }
+  }
+
+  for(const Vertex& vertex : vertices)
+  {
+    Label<> vertexLabel = heap.getLabel(vertex);
+    if(vertexLabel.getState() == State::SETTLED)
+    {
+      cache.insert(Entry{source, vertex, departureTime}, vertexLabel.getCost() - departureTime);
+    }
+  }
+
+  if(numPending > 0)
+  {
+    throw std::invalid_argument("Graph is not strongly connected");
+  }
+
+  for(idx i = 0; i < targets.size(); ++i)
+  {
+    values[i] = heap.getLabel(targets[i]).getCost() - departureTime;
+  }
+}
+
 #endif /* CACHED_TREE_DISTANCES_HH */
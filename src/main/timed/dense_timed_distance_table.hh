@@ -0,0 +1,221 @@
+#ifndef DENSE_TIMED_DISTANCE_TABLE_HH
+#define DENSE_TIMED_DISTANCE_TABLE_HH
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "graph/graph.hh"
+#include "graph/vertex_map.hh"
+
+#include "router/label.hh"
+#include "router/label_heap.hh"
+
+#include "timed_edge_func.hh"
+#include "timed_vertex_func.hh"
+
+#include "log.hh"
+#include "parallel.hh"
+
+/**
+ * A TimedDistanceFunc which precomputes the travel times between
+ * all pairs of the given vertices for all departure times in
+ * [0, timeHorizon). The travel times are stored in a contiguous
+ * table indexed by [departureTime][source][target], so queries
+ * amount to a single lookup.
+ *
+ * The table is filled in parallel by computing one shortest path
+ * tree per source and departure time. The cost function must be
+ * defined for all arrival times of these trees.
+ *
+ * @tparam T The type used to store travel times, e.g., uint16_t
+ *           to reduce the memory consumption on larger instances
+ **/
+template <class T = num>
+class DenseTimedDistanceTable : public TimedDistanceFunc
+{
+private:
+  const Graph& graph;
+  std::vector<Vertex> vertices;
+  VertexMap<idx> positions;
+  idx timeHorizon;
+  std::vector<T> table;
+
+  static constexpr idx invalid = std::numeric_limits<idx>::max();
+
+  std::size_t index(idx departureTime, idx source, idx target) const
+  {
+    const std::size_t size = vertices.size();
+    return (departureTime * size + source) * size + target;
+  }
+
+  template <class Costs>
+  void computeTree(const Costs& costs,
+                   idx source,
+                   idx departureTime);
+
+public:
+  /**
+   * The trees are computed for the static type of the given costs,
+   * so concrete cost functions are called without virtual dispatch.
+   **/
+  template <class Costs>
+  DenseTimedDistanceTable(const Graph& graph,
+                          const std::vector<Vertex>& vertices,
+                          const Costs& costs,
+                          idx timeHorizon,
+                          idx numThreads = defaultNumThreads());
+
+  num operator()(const Vertex& source,
+                 const Vertex& target,
+                 idx departureTime) override;
+
+  /**
+   * Reads the travel times of all targets from the
+   * table row of the source and departure time.
+   **/
+  void distances(const Vertex& source,
+                 idx departureTime,
+                 Span<const Vertex> targets,
+                 Span<num> values) override;
+
+  idx getTimeHorizon() const
+  {
+    return timeHorizon;
+  }
+};
+
+template <class T>
+template <class Costs>
+DenseTimedDistanceTable<T>::DenseTimedDistanceTable(const Graph& graph,
+                                                    const std::vector<Vertex>& vertices,
+                                                    const Costs& costs,
+                                                    idx timeHorizon,
+                                                    idx numThreads)
+  : graph(graph),
+    vertices(vertices),
+    positions(graph, invalid),
+    timeHorizon(timeHorizon),
+    table(((std::size_t) timeHorizon) * vertices.size() * vertices.size(), 0)
+{
+  for(idx i = 0; i < vertices.size(); ++i)
+  {
+    positions(vertices[i]) = i;
+  }
+
+  Log(info) << "Computing travel times between " << vertices.size()
+            << " vertices for " << timeHorizon << " departure times";
+
+  const idx size = vertices.size();
+
+  parallelFor(timeHorizon * size,
+              [&](idx i)
+              {
+                computeTree(costs, i % size, i / size);
+              },
+              numThreads);
+}
+
+template <class T>
+template <class Costs>
+void DenseTimedDistanceTable<T>::computeTree(const Costs& costs,
+                                             idx source,
+                                             idx departureTime)
+{
+  RadixLabelHeap<Label<>> heap(graph);
+
+  heap.update(Label<>(vertices[source], Edge(), departureTime));
+
+  while(!heap.isEmpty())
+  {
+    const Label<>& current = heap.extractMin();
+
+    for(const Edge& edge : graph.getOutgoing(current.getVertex()))
+    {
+      heap.update(Label<>(edge.getTarget(),
+                          edge,
+                          current.getCost() + costs(edge, current.getCost())));
+    }
+  }
+
+  for(idx target = 0; target < vertices.size(); ++target)
+  {
+    const Label<>& label = heap.getLabel(vertices[target]);
+
+    if(label.getState() != State::SETTLED)
+    {
+      throw std::invalid_argument("Graph is not strongly connected");
+    }
+
+    const num travelTime = label.getCost() - departureTime;
+
+    if(travelTime > std::numeric_limits<T>::max())
+    {
+      throw std::overflow_error("Travel time exceeds the range of the table");
+    }
+
+    table[index(departureTime, source, target)] = (T) travelTime;
+  }
+}
+
+template <class T>
+num DenseTimedDistanceTable<T>::operator()(const Vertex& source,
+                                           const Vertex& target,
+                                           idx departureTime)
+{
+  if(debuggingEnabled())
+  {
+    if(departureTime >= timeHorizon)
+    {
+      throw std::out_of_range("Departure time exceeds the time horizon");
+    }
+
+    if(positions(source) == invalid or positions(target) == invalid)
+    {
+      throw std::invalid_argument("Vertex is not contained in the table");
+    }
+  }
+
+  return table[index(departureTime, positions(source), positions(target))];
+}
+
+template <class T>
+void DenseTimedDistanceTable<T>::distances(const Vertex& source,
+                                           idx departureTime,
+                                           Span<const Vertex> targets,
+                                           Span<num> values)
+{
+  if(targets.size() != values.size())
+  {
+    throw std::invalid_argument("Numbers of targets and values differ");
+  }
+
+  if(debuggingEnabled())
+  {
+    if(departureTime >= timeHorizon)
+    {
+      throw std::out_of_range("Departure time exceeds the time horizon");
+    }
+
+    if(positions(source) == invalid)
+    {
+      throw std::invalid_argument("Vertex is not contained in the table");
+    }
+  }
+
+  const T* row = table.data() + index(departureTime, positions(source), 0);
+
+  for(idx i = 0; i < targets.size(); ++i)
+  {
+    const idx position = positions(targets[i]);
+
+    if(debuggingEnabled() and position == invalid)
+    {
+      throw std::invalid_argument("Vertex is not contained in the table");
+    }
+
+    values[i] = row[position];
+  }
+}
+
+#endif /* DENSE_TIMED_DISTANCE_TABLE_HH */
@@ -0,0 +1,208 @@
+#include "piecewise_linear_func.hh"
+
+#include <cassert>
+#include <stdexcept>
+
+void PiecewiseLinearFunc::push_back(num value)
+{
+  append(1, value, 0);
+}
+
+void PiecewiseLinearFunc::append(idx length, num value, num slope)
+{
+  if(length == 0)
+  {
+    return;
+  }
+
+  if(!breakpoints.empty())
+  {
+    Breakpoint& last = breakpoints.back();
+    const num lastLength = horizon - last.time;
+
+    // A piece consisting of a single point takes any slope
+    if(lastLength == 1)
+    {
+      if(length == 1 or value - last.value == slope)
+      {
+        last.slope = value - last.value;
+        horizon += length;
+        return;
+      }
+    }
+    else if(last.value + last.slope * lastLength == value and
+            (length == 1 or last.slope == slope))
+    {
+      horizon += length;
+      return;
+    }
+  }
+
+  breakpoints.push_back(Breakpoint{horizon, value, slope});
+  horizon += length;
+}
+
+const PiecewiseLinearFunc::Breakpoint& PiecewiseLinearFunc::find(idx time) const
+{
+  assert(time < horizon);
+  assert(!breakpoints.empty());
+
+  auto it = std::upper_bound(std::begin(breakpoints),
+                             std::end(breakpoints),
+                             time,
+                             [](idx time, const Breakpoint& breakpoint) -> bool
+                             {
+                               return time < breakpoint.time;
+                             });
+
+  assert(it != std::begin(breakpoints));
+
+  return *(--it);
+}
+
+num PiecewiseLinearFunc::operator()(idx time) const
+{
+  const Breakpoint& breakpoint = find(time);
+
+  return breakpoint.value + breakpoint.slope * ((num) (time - breakpoint.time));
+}
+
+PiecewiseLinearFunc PiecewiseLinearFunc::link(const PiecewiseLinearFunc& travelTimes) const
+{
+  PiecewiseLinearFunc result;
+
+  // index of the current piece of the travel times,
+  // advanced monotonically since arrival times do not decrease
+  idx j = 0;
+
+  for(idx i = 0; i < breakpoints.size(); ++i)
+  {
+    const Breakpoint& piece = breakpoints[i];
+    const idx end = pieceEnd(i);
+    const num slope = (end - piece.time == 1) ? 0 : piece.slope;
+
+    if(slope < 0)
+    {
+      throw std::invalid_argument("Arrival times must not decrease");
+    }
+
+    idx time = piece.time;
+
+    while(time < end)
+    {
+      const num arrival = piece.value + slope * ((num) (time - piece.time));
+
+      if(arrival < 0 or ((idx) arrival) >= travelTimes.getHorizon())
+      {
+        throw std::out_of_range("Arrival time exceeds the time horizon");
+      }
+
+      while(travelTimes.pieceEnd(j) <= (idx) arrival)
+      {
+        ++j;
+      }
+
+      const Breakpoint& edgePiece = travelTimes.breakpoints[j];
+      const num edgeEnd = travelTimes.pieceEnd(j);
+
+      // first time at which the arrival leaves the current piece
+      idx nextTime = end;
+
+      if(slope > 0)
+      {
+        const num remaining = edgeEnd - arrival;
+        nextTime = std::min(end, time + (idx) ((remaining + slope - 1) / slope));
+      }
+
+      const num edgeSlope = (edgeEnd - edgePiece.time == 1) ? 0 : edgePiece.slope;
+      const num travelTime = edgePiece.value + edgeSlope * (arrival - (num) edgePiece.time);
+
+      result.append(nextTime - time,
+                    arrival + travelTime,
+                    slope * (1 + edgeSlope));
+
+      time = nextTime;
+    }
+  }
+
+  return result;
+}
+
+PiecewiseLinearFunc PiecewiseLinearFunc::minimum(const PiecewiseLinearFunc& first,
+                                                 const PiecewiseLinearFunc& second,
+                                                 bool& improved)
+{
+  if(first.getHorizon() != second.getHorizon())
+  {
+    throw std::invalid_argument("Functions are defined on different time steps");
+  }
+
+  PiecewiseLinearFunc result;
+  improved = false;
+
+  idx i = 0, j = 0, time = 0;
+
+  while(time < first.getHorizon())
+  {
+    const Breakpoint& firstPiece = first.breakpoints[i];
+    const Breakpoint& secondPiece = second.breakpoints[j];
+
+    const idx firstEnd = first.pieceEnd(i);
+    const idx secondEnd = second.pieceEnd(j);
+    const idx end = std::min(firstEnd, secondEnd);
+    const num length = end - time;
+
+    const num firstValue = firstPiece.value + firstPiece.slope * ((num) (time - firstPiece.time));
+    const num secondValue = secondPiece.value + secondPiece.slope * ((num) (time - secondPiece.time));
+
+    const num firstSlope = (length == 1) ? 0 : firstPiece.slope;
+    const num secondSlope = (length == 1) ? 0 : secondPiece.slope;
+
+    // the difference of both functions is linear within [time, end)
+    const num initialDifference = firstValue - secondValue;
+    const num differenceSlope = firstSlope - secondSlope;
+    const num finalDifference = initialDifference + differenceSlope * (length - 1);
+
+    if(initialDifference <= 0 and finalDifference <= 0)
+    {
+      result.append(length, firstValue, firstSlope);
+    }
+    else if(initialDifference > 0 and finalDifference > 0)
+    {
+      improved = true;
+      result.append(length, secondValue, secondSlope);
+    }
+    else if(initialDifference <= 0)
+    {
+      // the second function becomes smaller
+      improved = true;
+      const num split = (-initialDifference) / differenceSlope + 1;
+
+      result.append(split, firstValue, firstSlope);
+      result.append(length - split, secondValue + secondSlope * split, secondSlope);
+    }
+    else
+    {
+      // the first function becomes smaller
+      improved = true;
+      const num split = (initialDifference - differenceSlope - 1) / (-differenceSlope);
+
+      result.append(split, secondValue, secondSlope);
+      result.append(length - split, firstValue + firstSlope * split, firstSlope);
+    }
+
+    time = end;
+
+    if(end == firstEnd)
+    {
+      ++i;
+    }
+
+    if(end == secondEnd)
+    {
+      ++j;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,114 @@
+#ifndef PIECEWISE_LINEAR_FUNC_HH
+#define PIECEWISE_LINEAR_FUNC_HH
+
+#include <vector>
+
+#include "util.hh"
+
+/**
+ * A function defined on the discrete time steps [0, horizon)
+ * which is stored as a sequence of linear pieces. Only the
+ * breakpoints between pieces are stored, so the memory
+ * consumption depends on the number of breakpoints rather
+ * than on the time horizon.
+ **/
+class PiecewiseLinearFunc
+{
+public:
+  /**
+   * A breakpoint of the function. The function takes the
+   * value "value + slope * (t - time)" for all times t
+   * up to (and excluding) the time of the next breakpoint.
+   **/
+  struct Breakpoint
+  {
+    idx time;
+    num value;
+    num slope;
+  };
+
+private:
+  std::vector<Breakpoint> breakpoints;
+  idx horizon;
+
+  /**
+   * Returns the breakpoint defining the function
+   * at the given time.
+   **/
+  const Breakpoint& find(idx time) const;
+
+  /**
+   * Returns the time of the breakpoint following the
+   * breakpoint with the given index.
+   **/
+  idx pieceEnd(idx index) const
+  {
+    return (index + 1 < breakpoints.size())
+      ? breakpoints[index + 1].time
+      : horizon;
+  }
+
+public:
+  PiecewiseLinearFunc()
+    : horizon(0)
+  {}
+
+  /**
+   * Appends a value for the next time step (i.e., for the
+   * current horizon), extending the last piece if possible.
+   **/
+  void push_back(num value);
+
+  /**
+   * Appends a linear piece of the given length starting
+   * at the current horizon, extending the last piece if possible.
+   **/
+  void append(idx length, num value, num slope);
+
+  /**
+   * Evaluates the function at the given time, which must be
+   * smaller than the horizon. Evaluation is logarithmic in the
+   * number of breakpoints.
+   **/
+  num operator()(idx time) const;
+
+  /**
+   * Returns the number of time steps for which the function
+   * is defined.
+   **/
+  idx getHorizon() const
+  {
+    return horizon;
+  }
+
+  const std::vector<Breakpoint>& getBreakpoints() const
+  {
+    return breakpoints;
+  }
+
+  void shrink_to_fit()
+  {
+    breakpoints.shrink_to_fit();
+  }
+
+  /**
+   * Regarding this function as a non-decreasing function of arrival
+   * times, returns the arrival times after additionally traversing
+   * an Edge with the given travel times. The travel times must be
+   * defined for all arrival times of this function.
+   **/
+  PiecewiseLinearFunc link(const PiecewiseLinearFunc& travelTimes) const;
+
+  /**
+   * Returns the pointwise minimum of two functions defined
+   * on the same time steps.
+   *
+   * @param improved Set to whether the second function is
+   *                 smaller than the first one at any time
+   **/
+  static PiecewiseLinearFunc minimum(const PiecewiseLinearFunc& first,
+                                     const PiecewiseLinearFunc& second,
+                                     bool& improved);
+};
+
+#endif /* PIECEWISE_LINEAR_FUNC_HH */
@@ -0,0 +1,166 @@
+#include "profile_distances.hh"
+
+#include <limits>
+#include <queue>
+#include <stdexcept>
+
+#include "log.hh"
+
+#include "graph/vertex_set.hh"
+
+namespace
+{
+  const idx invalid = std::numeric_limits<idx>::max();
+
+  struct QueueEntry
+  {
+    num key;
+    Vertex vertex;
+
+    bool operator>(const QueueEntry& other) const
+    {
+      return key > other.key;
+    }
+  };
+}
+
+ProfileDistances::ProfileDistances(const Graph& graph,
+                                   const std::vector<Vertex>& vertices,
+                                   const AugmentedEdgeFunc& costs,
+                                   idx timeHorizon)
+  : graph(graph),
+    vertices(vertices),
+    costs(costs),
+    timeHorizon(timeHorizon),
+    positions(graph, invalid),
+    profiles(vertices.size()),
+    computed(new std::once_flag[vertices.size()])
+{
+  for(idx i = 0; i < vertices.size(); ++i)
+  {
+    positions(vertices[i]) = i;
+  }
+}
+
+idx ProfileDistances::getPosition(const Vertex& vertex) const
+{
+  const idx position = positions(vertex);
+
+  if(position == invalid)
+  {
+    throw std::invalid_argument("Vertex is not contained in the profiles");
+  }
+
+  return position;
+}
+
+void ProfileDistances::computeProfiles(idx source)
+{
+  // A label-correcting search on arrival time functions. Since the
+  // travel times satisfy the FIFO property, linking and taking the
+  // minimum preserves non-decreasing arrival times.
+  VertexMap<PiecewiseLinearFunc> labels(graph, PiecewiseLinearFunc());
+  VertexSet queued(graph);
+
+  std::priority_queue<QueueEntry,
+                      std::vector<QueueEntry>,
+                      std::greater<QueueEntry>> queue;
+
+  const Vertex sourceVertex = vertices[source];
+
+  labels(sourceVertex).append(timeHorizon, 0, 1);
+  queued.insert(sourceVertex);
+  queue.push(QueueEntry{0, sourceVertex});
+
+  idx relaxed = 0;
+
+  while(!queue.empty())
+  {
+    const Vertex current = queue.top().vertex;
+    queue.pop();
+
+    if(!queued.contains(current))
+    {
+      continue;
+    }
+
+    queued.remove(current);
+
+    for(const Edge& edge : graph.getOutgoing(current))
+    {
+      ++relaxed;
+
+      const Vertex target = edge.getTarget();
+
+      PiecewiseLinearFunc arrivals = labels(current).link(costs.getFunc(edge));
+
+      PiecewiseLinearFunc& label = labels(target);
+
+      if(label.getHorizon() == 0)
+      {
+        label = std::move(arrivals);
+      }
+      else
+      {
+        bool improved;
+
+        PiecewiseLinearFunc nextLabel = PiecewiseLinearFunc::minimum(label,
+                                                                     arrivals,
+                                                                     improved);
+
+        if(!improved)
+        {
+          continue;
+        }
+
+        label = std::move(nextLabel);
+      }
+
+      queued.insert(target);
+      queue.push(QueueEntry{label(0), target});
+    }
+  }
+
+  std::vector<PiecewiseLinearFunc>& sourceProfiles = profiles[source];
+  sourceProfiles.reserve(vertices.size());
+
+  for(const Vertex& target : vertices)
+  {
+    if(labels(target).getHorizon() == 0)
+    {
+      throw std::invalid_argument("Graph is not strongly connected");
+    }
+
+    sourceProfiles.push_back(std::move(labels(target)));
+    sourceProfiles.back().shrink_to_fit();
+  }
+
+  Log(debug) << "Computed profiles of vertex " << sourceVertex
+             << " after " << relaxed << " relaxations";
+}
+
+const PiecewiseLinearFunc& ProfileDistances::arrivalTimes(const Vertex& source,
+                                                          const Vertex& target)
+{
+  const idx sourcePosition = getPosition(source);
+  const idx targetPosition = getPosition(target);
+
+  std::call_once(computed[sourcePosition],
+                 &ProfileDistances::computeProfiles,
+                 this,
+                 sourcePosition);
+
+  return profiles[sourcePosition][targetPosition];
+}
+
+num ProfileDistances::operator()(const Vertex& source,
+                                 const Vertex& target,
+                                 idx departureTime)
+{
+  if(departureTime >= timeHorizon)
+  {
+    throw std::out_of_range("Departure time exceeds the time horizon");
+  }
+
+  return arrivalTimes(source, target)(departureTime) - departureTime;
+}
@@ -0,0 +1,67 @@
+#ifndef PROFILE_DISTANCES_HH
+#define PROFILE_DISTANCES_HH
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "graph/graph.hh"
+#include "graph/vertex_map.hh"
+
+#include "augmented_edge_func.hh"
+#include "piecewise_linear_func.hh"
+#include "timed_vertex_func.hh"
+
+/**
+ * A TimedDistanceFunc which answers queries using travel time
+ * profiles. For each source a single profile search computes the
+ * arrival times at all given vertices as PiecewiseLinearFunc%s of
+ * the departure time, based on the piecewise linear travel times
+ * of an AugmentedEdgeFunc. Afterwards, each query amounts to
+ * the evaluation of a profile.
+ *
+ * Profiles are computed on demand, the computation is thread-safe.
+ * The travel times must be defined for all arrival times
+ * when departing within the given time horizon.
+ **/
+class ProfileDistances : public TimedDistanceFunc
+{
+private:
+  const Graph& graph;
+  std::vector<Vertex> vertices;
+  const AugmentedEdgeFunc& costs;
+  idx timeHorizon;
+  VertexMap<idx> positions;
+
+  // arrival times, indexed by source and target position
+  std::vector<std::vector<PiecewiseLinearFunc>> profiles;
+  std::unique_ptr<std::once_flag[]> computed;
+
+  void computeProfiles(idx source);
+
+  idx getPosition(const Vertex& vertex) const;
+
+public:
+  ProfileDistances(const Graph& graph,
+                   const std::vector<Vertex>& vertices,
+                   const AugmentedEdgeFunc& costs,
+                   idx timeHorizon);
+
+  num operator()(const Vertex& source,
+                 const Vertex& target,
+                 idx departureTime) override;
+
+  /**
+   * Returns the arrival times at the given target
+   * as a function of the departure time at the given source.
+   **/
+  const PiecewiseLinearFunc& arrivalTimes(const Vertex& source,
+                                          const Vertex& target);
+
+  idx getTimeHorizon() const
+  {
+    return timeHorizon;
+  }
+};
+
+#endif /* PROFILE_DISTANCES_HH */
@@ -32,13 +32,16 @@ AcyclicHoleFreeTimeExpandedRouter<size>::findShortestPaths(const TimeExpandedRou
 
   Log(info) << "Finding new " << size << "-cycle free paths";
 
+  // released in bulk when the search is finished
+  LabelPool<size> pool;
+
   VertexMap<LabelSet<size>> labels(graph, LabelSet<size>());
 
   VertexMap<ReverseLabel> lowerBounds =findLowerBounds(request);
 
   TimedVertex timedSource = graph.getVertex(originalSource, 0);
 
-  labels(timedSource).insert(std::make_shared<LargeLabel<size>>(timedSource, originalSource, 0));
+  labels(timedSource).insert(pool.create(timedSource, originalSource, 0));
 
   idx numLabels = 0;
 
@@ -250,12 +253,12 @@ AcyclicHoleFreeTimeExpandedRouter<size>::findShortestPaths(const TimeExpandedRou
           continue;
         }
 
-        const double edgeCost = request.costs(outgoing);
+        const double edgeCost = request.edgeCost(outgoing);
 
-        LabelPtr<size> nextLabel = std::make_shared<LargeLabel<size>>(outgoing,
-                                                                      graph.underlyingVertex(outgoing.getTarget()),
-                                                                      currentLabel->getCost() + edgeCost,
-                                                                      currentLabel);
+        LabelPtr<size> nextLabel = pool.create(outgoing,
+                                               graph.underlyingVertex(outgoing.getTarget()),
+                                               currentLabel->getCost() + edgeCost,
+                                               currentLabel);
 
         ++numLabels;
 
@@ -31,13 +31,16 @@ AcyclicTimeExpandedRouter<size>::findShortestPaths(const TimeExpandedRouter::Req
 
   Log(info) << "Finding new " << size << "-cycle free paths";
 
+  // released in bulk when the search is finished
+  LabelPool<size> pool;
+
   VertexMap<LabelSet<size>> labels(graph, LabelSet<size>());
 
   VertexMap<ReverseLabel> lowerBounds =findLowerBounds(request);
 
   TimedVertex timedSource = graph.getVertex(originalSource, 0);
 
-  labels(timedSource).insert(std::make_shared<LargeLabel<size>>(timedSource, originalSource, 0));
+  labels(timedSource).insert(pool.create(timedSource, originalSource, 0));
 
   std::optional<double> minCost;
 
@@ -184,12 +187,12 @@ AcyclicTimeExpandedRouter<size>::findShortestPaths(const TimeExpandedRouter::Req
           continue;
         }
 
-        const double edgeCost = request.costs(outgoing);
+        const double edgeCost = request.edgeCost(outgoing);
 
-        LabelPtr<size> nextLabel = std::make_shared<LargeLabel<size>>(outgoing,
-                                                                      graph.underlyingVertex(outgoing.getTarget()),
-                                                                      currentLabel->getCost() + edgeCost,
-                                                                      currentLabel);
+        LabelPtr<size> nextLabel = pool.create(outgoing,
+                                               graph.underlyingVertex(outgoing.getTarget()),
+                                               currentLabel->getCost() + edgeCost,
+                                               currentLabel);
 
         ++numLabels;
 
@@ -14,33 +14,34 @@ public:
   typedef std::optional<Vertex> Entry;
   typedef std::array<Entry, size> Entries;
 private:
-  std::shared_ptr<Entries> entries;
+  // stored inline, set forms are small and created in large numbers
+  Entries entries;
 
   SetForm()
-    : entries(std::make_shared<Entries>())
+    : entries()
   {
 
   }
 
   Entries& getEntries()
   {
-    return *entries;
+    return entries;
   }
 
   Entry& getEntry(idx i)
   {
-    return (*entries)[i];
+    return entries[i];
   }
 
 public:
   const Entry& getEntry(idx i) const
   {
-    return (*entries)[i];
+    return entries[i];
   }
 
   const Entries& getEntries() const
   {
-    return *entries;
+    return entries;
   }
 
   bool operator<=(const SetForm<size>& other) const
@@ -3,6 +3,9 @@
 
 #include <array>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
 
 #include "time_expanded_router.hh"
 
@@ -31,8 +34,12 @@ struct LabelPrefixHasher
 template<idx size>
 class LargeLabel;
 
+/**
+ * Labels are owned by a LabelPool, which
+ * releases all of them at once.
+ **/
 template<idx size>
-using LabelPtr = std::shared_ptr<LargeLabel<size>>;
+using LabelPtr = LargeLabel<size>*;
 
 template<idx size>
 class LargeLabel
@@ -153,6 +160,55 @@ public:
 
 };
 
+/**
+ * An arena of LargeLabels. Labels are allocated in large chunks
+ * and are only released together with the pool, avoiding separate
+ * allocations and reference counting for each label.
+ **/
+template <idx size>
+class LabelPool
+{
+private:
+  static const idx chunkSize = 4096;
+
+  typedef std::aligned_storage_t<sizeof(LargeLabel<size>),
+                                 alignof(LargeLabel<size>)> Storage;
+
+  std::vector<std::unique_ptr<Storage[]>> chunks;
+  idx chunkPosition;
+
+public:
+  LabelPool()
+    : chunkPosition(chunkSize)
+  {}
+
+  LabelPool(const LabelPool& other) = delete;
+
+  LabelPool& operator=(const LabelPool& other) = delete;
+
+  template <class... Args>
+  LabelPtr<size> create(Args&&... args)
+  {
+    static_assert(std::is_trivially_destructible<LargeLabel<size>>::value,
+                  "Labels are released without being destroyed");
+
+    if(chunkPosition == chunkSize)
+    {
+      chunks.push_back(std::unique_ptr<Storage[]>(new Storage[chunkSize]));
+      chunkPosition = 0;
+    }
+
+    Storage* storage = chunks.back().get() + (chunkPosition++);
+
+    return new (storage) LargeLabel<size>(std::forward<Args>(args)...);
+  }
+
+  std::size_t numLabels() const
+  {
+    return chunks.empty() ? 0 : (chunks.size() - 1) * chunkSize + chunkPosition;
+  }
+};
+
 template <idx size>
 class LabelSet
 {
@@ -139,7 +139,7 @@ SimpleTimeExpandedRouter::findShortestPaths(const Request& request)
 
       Label& nextLabel = labels(outgoing.getTarget());
 
-      const double edgeCost = request.costs(outgoing);
+      const double edgeCost = request.edgeCost(outgoing);
 
       const double nextCost = currentLabel.getCost() + edgeCost;
 
@@ -47,7 +47,7 @@ TimeExpandedRouter::findLowerBounds(const Request& request) const
 
       auto& nextLabel = labels(incoming.getSource());
 
-      const double edgeCost = request.costs(incoming);
+      const double edgeCost = request.edgeCost(incoming);
 
       const double nextCost = currentLabel.getCost() + edgeCost;
 
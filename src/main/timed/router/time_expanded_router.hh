@@ -3,6 +3,7 @@
 
 #include <optional>
 
+#include "graph/edge_map.hh"
 #include "graph/edge_set.hh"
 
 #include "timed/time_expanded_graph.hh"
@@ -72,13 +73,34 @@ public:
     Request(const EdgeFunc<double>& costs,
             const EdgeSet& forbiddenEdges)
       : forbiddenEdges(forbiddenEdges),
-        costs(costs)
+        costs(costs),
+        costValues(nullptr)
+    {}
+
+    /**
+     * Creates a request for costs stored contiguously in the given
+     * map, which the routers read directly rather than
+     * calling the (virtual) cost function for each edge.
+     **/
+    Request(const EdgeMap<double>& costs,
+            const EdgeSet& forbiddenEdges)
+      : forbiddenEdges(forbiddenEdges),
+        costs(costs.getValues()),
+        costValues(costs.data())
     {}
 
     EdgeSet forbiddenEdges;
 
     const EdgeFunc<double>& costs;
 
+    // The costs indexed by timed edges, if stored contiguously
+    const double* costValues;
+
+    double edgeCost(const Edge& edge) const
+    {
+      return costValues ? costValues[edge.getIndex()] : costs(edge);
+    }
+
     std::optional<double> cutoffCost;
 
     std::optional<double> lowerTimeBound;
@@ -379,7 +379,7 @@ TwoCycleFreeTimeExpandedRouter::findShortestPaths(const Request& request)
 
       const TimedVertex nextVertex = outgoing.getTarget();
 
-      const double edgeCosts = request.costs(outgoing);
+      const double edgeCosts = request.edgeCost(outgoing);
 
       if(graph.underlyingVertex(nextVertex) ==
          graph.underlyingVertex(bestLabel.getEdge().getSource()))
@@ -1,27 +1,189 @@
 #include "time_expanded_graph.hh"
 
-TimeExpandedGraph::TimeExpandedGraph(const Graph& underlyingGraph)
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+  // maximum number of entries of the dense vertex lookup
+  const std::size_t maxDenseSize = 1 << 24;
+
+  struct TimeCompare
+  {
+    bool operator()(const std::pair<idx, Vertex>& entry, idx time) const
+    {
+      return entry.first < time;
+    }
+  };
+
+  const char fileMagic[8] = {'T', 'E', 'G', 'R', 'A', 'P', 'H', '1'};
+
+  // incremented whenever the file layout changes
+  const uint32_t fileVersion = 2;
+
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t numUnderlyingVertices;
+    uint32_t numUnderlyingEdges;
+    uint32_t timeHorizon;
+    uint32_t numVertices;
+    uint32_t numEdges;
+    uint64_t key;
+  };
+
+  struct FileVertex
+  {
+    uint32_t underlyingVertex;
+    uint32_t time;
+  };
+
+  struct FileEdge
+  {
+    uint32_t source;
+    uint32_t target;
+    uint32_t underlyingEdge;
+  };
+
+  /**
+   * A read-only memory mapping of a file which is
+   * unmapped upon destruction.
+   **/
+  class MappedFile
+  {
+  private:
+    void* data;
+    std::size_t size;
+
+  public:
+    MappedFile(const std::string& filename)
+      : data(nullptr),
+        size(0)
+    {
+      const int fd = open(filename.c_str(), O_RDONLY);
+
+      if(fd == -1)
+      {
+        throw std::invalid_argument("Could not open file " + filename);
+      }
+
+      struct stat info;
+
+      if(fstat(fd, &info) == -1)
+      {
+        close(fd);
+        throw std::invalid_argument("Could not read file " + filename);
+      }
+
+      size = info.st_size;
+
+      if(size > 0)
+      {
+        data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      }
+
+      close(fd);
+
+      if(data == MAP_FAILED)
+      {
+        throw std::invalid_argument("Could not map file " + filename);
+      }
+    }
+
+    MappedFile(const MappedFile& other) = delete;
+
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    const char* begin() const
+    {
+      return (const char*) data;
+    }
+
+    std::size_t getSize() const
+    {
+      return size;
+    }
+
+    ~MappedFile()
+    {
+      if(data)
+      {
+        munmap(data, size);
+      }
+    }
+  };
+}
+
+TimeExpandedGraph::TimeExpandedGraph(const Graph& underlyingGraph, idx timeHorizon)
   : graph(0, {}),
     underlying(underlyingGraph),
-    vertexTimes(underlying, std::map<idx, Vertex>()),
+    vertexTimes(underlying, VertexTimes()),
+    denseHorizon(0),
     underlyingVertices(*this, Vertex()),
     underlyingEdges(*this, Edge()),
     timedEdges(underlying, std::vector<TimedEdge>{}),
     times(*this, 0)
 {
+  const std::size_t denseSize = ((std::size_t) timeHorizon + 1) *
+    underlying.getVertices().size();
+
+  if(timeHorizon > 0 and denseSize <= maxDenseSize)
+  {
+    denseHorizon = timeHorizon + 1;
+    denseVertices.resize(denseSize, Vertex());
+  }
+}
+
+const Vertex* TimeExpandedGraph::findVertex(Vertex vertex, idx time) const
+{
+  if(time < denseHorizon)
+  {
+    const Vertex& denseVertex = denseVertices[vertex.getIndex() * denseHorizon + time];
+
+    return (denseVertex == Vertex()) ? nullptr : &denseVertex;
+  }
+
+  const VertexTimes& currentTimes = vertexTimes(vertex);
+
+  auto it = std::lower_bound(std::begin(currentTimes),
+                             std::end(currentTimes),
+                             time,
+                             TimeCompare{});
+
+  if(it == std::end(currentTimes) or it->first != time)
+  {
+    return nullptr;
+  }
+
+  return &(it->second);
 }
 
 TimedVertex TimeExpandedGraph::addVertex(Vertex vertex, idx time)
 {
-  std::map<idx, Vertex>& currentMap = vertexTimes(vertex);
+  VertexTimes& currentTimes = vertexTimes(vertex);
 
-  auto it = currentMap.find(time);
+  auto it = std::lower_bound(std::begin(currentTimes),
+                             std::end(currentTimes),
+                             time,
+                             TimeCompare{});
 
-  assert(it == currentMap.end());
+  assert(it == std::end(currentTimes) or it->first != time);
 
   Vertex nextVertex = graph.addVertex();
 
-  currentMap.insert(std::make_pair(time, nextVertex));
+  currentTimes.insert(it, std::make_pair(time, nextVertex));
+
+  if(time < denseHorizon)
+  {
+    denseVertices[vertex.getIndex() * denseHorizon + time] = nextVertex;
+  }
 
   underlyingVertices.addVertex(nextVertex, vertex);
   times.addVertex(nextVertex, time);
@@ -29,6 +191,146 @@ TimedVertex TimeExpandedGraph::addVertex(Vertex vertex, idx time)
   return TimedVertex(nextVertex.getIndex(), time);
 }
 
+void TimeExpandedGraph::write(const std::string& filename, uint64_t key) const
+{
+  std::ofstream output(filename, std::ios::binary);
+
+  if(!output)
+  {
+    throw std::invalid_argument("Could not open file " + filename);
+  }
+
+  FileHeader header;
+  std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+  header.version = fileVersion;
+  header.numUnderlyingVertices = underlying.getVertices().size();
+  header.numUnderlyingEdges = underlying.getEdges().size();
+  header.timeHorizon = (denseHorizon > 0) ? denseHorizon - 1 : 0;
+  header.numVertices = graph.getVertices().size();
+  header.numEdges = graph.getEdges().size();
+  header.key = key;
+
+  std::vector<FileVertex> fileVertices;
+  fileVertices.reserve(header.numVertices);
+
+  for(const Vertex& vertex : graph.getVertices())
+  {
+    fileVertices.push_back(FileVertex{underlyingVertices(vertex).getIndex(),
+                                      times(vertex)});
+  }
+
+  std::vector<FileEdge> fileEdges;
+  fileEdges.reserve(header.numEdges);
+
+  for(const Edge& edge : graph.getEdges())
+  {
+    fileEdges.push_back(FileEdge{edge.getSource().getIndex(),
+                                 edge.getTarget().getIndex(),
+                                 underlyingEdges(edge).getIndex()});
+  }
+
+  output.write((const char*) &header, sizeof(header));
+  output.write((const char*) fileVertices.data(), fileVertices.size() * sizeof(FileVertex));
+  output.write((const char*) fileEdges.data(), fileEdges.size() * sizeof(FileEdge));
+
+  if(!output)
+  {
+    throw std::invalid_argument("Could not write file " + filename);
+  }
+}
+
+TimeExpandedGraph TimeExpandedGraph::read(const Graph& underlyingGraph,
+                                          const std::string& filename,
+                                          uint64_t key)
+{
+  MappedFile file(filename);
+
+  FileHeader header;
+
+  if(file.getSize() < sizeof(header))
+  {
+    throw std::invalid_argument("Invalid time-expanded graph file " + filename);
+  }
+
+  std::memcpy(&header, file.begin(), sizeof(header));
+
+  if(std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 or
+     header.version != fileVersion)
+  {
+    throw std::invalid_argument("Unsupported time-expanded graph file " + filename);
+  }
+
+  if(header.key != key)
+  {
+    throw std::invalid_argument("Time-expanded graph file " + filename +
+                                " was written for different inputs");
+  }
+
+  const std::size_t expectedSize = sizeof(header) +
+    ((std::size_t) header.numVertices) * sizeof(FileVertex) +
+    ((std::size_t) header.numEdges) * sizeof(FileEdge);
+
+  if(file.getSize() != expectedSize)
+  {
+    throw std::invalid_argument("Invalid time-expanded graph file " + filename);
+  }
+
+  const std::vector<Vertex> originalVertices = underlyingGraph.getVertices().collect();
+  const std::vector<Edge>& originalEdges = underlyingGraph.getEdges();
+
+  if(header.numUnderlyingVertices != originalVertices.size() or
+     header.numUnderlyingEdges != originalEdges.size())
+  {
+    throw std::invalid_argument("Time-expanded graph does not match the underlying graph");
+  }
+
+  const FileVertex* fileVertices = (const FileVertex*) (file.begin() + sizeof(header));
+  const FileEdge* fileEdges = (const FileEdge*) (fileVertices + header.numVertices);
+
+  TimeExpandedGraph graph(underlyingGraph, header.timeHorizon);
+
+  for(idx i = 0; i < header.numVertices; ++i)
+  {
+    const FileVertex& fileVertex = fileVertices[i];
+
+    if(fileVertex.underlyingVertex >= originalVertices.size() or
+       graph.hasVertex(originalVertices[fileVertex.underlyingVertex], fileVertex.time))
+    {
+      throw std::invalid_argument("Invalid vertex in time-expanded graph file " + filename);
+    }
+
+    graph.addVertex(originalVertices[fileVertex.underlyingVertex], fileVertex.time);
+  }
+
+  for(idx i = 0; i < header.numEdges; ++i)
+  {
+    const FileEdge& fileEdge = fileEdges[i];
+
+    if(fileEdge.source >= header.numVertices or
+       fileEdge.target >= header.numVertices or
+       fileEdge.underlyingEdge >= originalEdges.size())
+    {
+      throw std::invalid_argument("Invalid edge in time-expanded graph file " + filename);
+    }
+
+    const Edge& underlyingEdge = originalEdges[fileEdge.underlyingEdge];
+    const TimedVertex source = graph.asTimed(Vertex(fileEdge.source));
+    const TimedVertex target = graph.asTimed(Vertex(fileEdge.target));
+
+    if(graph.underlyingVertex(source) != underlyingEdge.getSource() or
+       graph.underlyingVertex(target) != underlyingEdge.getTarget())
+    {
+      throw std::invalid_argument("Invalid edge in time-expanded graph file " + filename);
+    }
+
+    graph.addEdge(source, target, underlyingEdge);
+  }
+
+  graph.compact();
+
+  return graph;
+}
+
 const std::vector<TimedVertex>& TimeExpandedGraph::getTopologicalOrdering() const
 {
   if(topologicalOrdering.size() != getVertices().size())
@@ -78,13 +380,11 @@ TimedEdge TimeExpandedGraph::getEdge(Edge edge, idx time) const
 
 TimedVertex TimeExpandedGraph::getVertex(Vertex vertex, idx time) const
 {
-  const std::map<idx, Vertex>& currentMap = vertexTimes(vertex);
-
-  auto it = currentMap.find(time);
+  const Vertex* timedVertex = findVertex(vertex, time);
 
-  if(it != currentMap.end())
+  if(timedVertex)
   {
-    return TimedVertex(it->second.getIndex(), time);
+    return TimedVertex(timedVertex->getIndex(), time);
   }
   else
   {
@@ -94,13 +394,11 @@ TimedVertex TimeExpandedGraph::getVertex(Vertex vertex, idx time) const
 
 TimedVertex TimeExpandedGraph::getVertex(Vertex vertex, idx time, bool add)
 {
-  std::map<idx, Vertex>& currentMap = vertexTimes(vertex);
+  const Vertex* timedVertex = findVertex(vertex, time);
 
-  auto it = currentMap.find(time);
-
-  if(it != currentMap.end())
+  if(timedVertex)
   {
-    return TimedVertex(it->second.getIndex(), time);
+    return TimedVertex(timedVertex->getIndex(), time);
   }
   else
   {
@@ -121,7 +419,7 @@ TimedVertex TimeExpandedGraph::asTimed(Vertex vertex) const
 }
 
 
-const std::map<idx, Vertex>&
+const TimeExpandedGraph::VertexTimes&
 TimeExpandedGraph::getVertexTimes(Vertex underlyingVertex) const
 {
   return vertexTimes(underlyingVertex);
@@ -129,7 +427,7 @@ TimeExpandedGraph::getVertexTimes(Vertex underlyingVertex) const
 
 const std::vector<TimedVertex> TimeExpandedGraph::getExpandedVertices(Vertex underlyingVertex) const
 {
-  const std::map<idx, Vertex>& times = vertexTimes(underlyingVertex);
+  const VertexTimes& times = vertexTimes(underlyingVertex);
   std::vector<TimedVertex> timedVertices;
   timedVertices.reserve(times.size());
 
@@ -161,16 +459,14 @@ TimedPath TimeExpandedGraph::expandPath(const Path& path) const
 
 bool TimeExpandedGraph::hasEdge(const Edge& edge, idx time) const
 {
-  const std::map<idx, Vertex>& currentMap = vertexTimes(edge.getSource());
-
-  auto it = currentMap.find(time);
+  const Vertex* sourceVertex = findVertex(edge.getSource(), time);
 
-  if(it == std::end(currentMap))
+  if(!sourceVertex)
   {
     return false;
   }
 
-  TimedVertex timedVertex(it->second.getIndex(), it->first);
+  TimedVertex timedVertex(sourceVertex->getIndex(), time);
 
   for(const TimedEdge& timedEdge : getOutgoing(timedVertex))
   {
@@ -185,9 +481,7 @@ bool TimeExpandedGraph::hasEdge(const Edge& edge, idx time) const
 
 bool TimeExpandedGraph::hasVertex(Vertex vertex, idx time) const
 {
-  const std::map<idx, Vertex>& currentMap = vertexTimes(vertex);
-
-  return currentMap.find(time) != currentMap.end();
+  return findVertex(vertex, time) != nullptr;
 }
 
 Vertex TimeExpandedGraph::underlyingVertex(TimedVertex timedVertex) const
@@ -1,7 +1,10 @@
 #ifndef TIME_EXPANDED_GRAPH_HH
 #define TIME_EXPANDED_GRAPH_HH
 
-#include <map>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "graph/graph.hh"
 
@@ -20,11 +23,11 @@ public:
   {
   private:
     const TimeExpandedGraph& graph;
-    std::vector<Edge>::const_iterator it;
+    EdgeSpan::const_iterator it;
 
   public:
     EdgeIterator(const TimeExpandedGraph& graph,
-                 std::vector<Edge>::const_iterator it)
+                 EdgeSpan::const_iterator it)
       : graph(graph), it(it)
     {}
 
@@ -55,10 +58,10 @@ public:
   {
   private:
     const TimeExpandedGraph& graph;
-    const std::vector<Edge>& edges;
+    EdgeSpan edges;
   public:
     Edges(const TimeExpandedGraph& graph,
-          const std::vector<Edge>& edges)
+          EdgeSpan edges)
       : graph(graph), edges(edges)
     {}
 
@@ -170,10 +173,23 @@ public:
     }
   };
 
+  /**
+   * The expanded vertices of an underlying Vertex
+   * together with their times, sorted by time.
+   **/
+  typedef std::vector<std::pair<idx, Vertex>> VertexTimes;
+
 private:
   Graph graph;
   const Graph& underlying;
-  VertexMap<std::map<idx, Vertex>> vertexTimes;
+  VertexMap<VertexTimes> vertexTimes;
+
+  // Vertices indexed by underlying vertex and time, only
+  // used if the time horizon is known and sufficiently small
+  idx denseHorizon;
+  std::vector<Vertex> denseVertices;
+
+  const Vertex* findVertex(Vertex vertex, idx time) const;
 
   VertexMap<Vertex> underlyingVertices;
   EdgeMap<Edge> underlyingEdges;
@@ -184,7 +200,12 @@ private:
   VertexMap<idx> times;
 
 public:
-  TimeExpandedGraph(const Graph& underlyingGraph);
+  /**
+   * Constructs a new TimeExpandedGraph. If a time horizon is given,
+   * vertices up to the time horizon are retrieved by a direct
+   * lookup rather than by a binary search.
+   **/
+  TimeExpandedGraph(const Graph& underlyingGraph, idx timeHorizon = 0);
 
   TimedVertex addVertex(Vertex vertex, idx time);
 
@@ -211,6 +232,39 @@ public:
 
   const std::vector<TimedVertex>& getTopologicalOrdering() const;
 
+  /**
+   * Compacts the underlying Graph once the construction
+   * is finished, see Graph::compact().
+   **/
+  void compact()
+  {
+    graph.compact();
+  }
+
+  /**
+   * Writes the graph to the given file using a compact binary
+   * format, which stores the timed vertices and edges in the
+   * order of their indices. The header contains a format version
+   * and the given key, which identifies the inputs of the graph.
+   **/
+  void write(const std::string& filename, uint64_t key = 0) const;
+
+  /**
+   * Reads a graph written by write() with respect to the given
+   * underlying Graph. The file is memory mapped and the vertices
+   * and edges are added in their original order, preserving
+   * all indices. The resulting graph is compacted. Note that the
+   * graph is rebuilt from the mapped data rather than used in
+   * place, i.e., reading is not zero-copy and takes time linear
+   * in the size of the graph, it merely avoids the distance
+   * queries of an expansion. Throws an std::invalid_argument if
+   * the file has a different format version or was written
+   * with a different key.
+   **/
+  static TimeExpandedGraph read(const Graph& underlyingGraph,
+                                const std::string& filename,
+                                uint64_t key = 0);
+
   const std::vector<TimedEdge> getTimedEdges(const Edge& underlyingEdge) const
   {
     return timedEdges(underlyingEdge);
@@ -226,7 +280,7 @@ public:
     return underlying;
   }
 
-  const std::map<idx, Vertex>& getVertexTimes(Vertex underlyingVertex) const;
+  const VertexTimes& getVertexTimes(Vertex underlyingVertex) const;
 
   const std::vector<TimedVertex> getExpandedVertices(Vertex underlyingVertex) const;
 
@@ -27,7 +27,7 @@ public:
     : costs(costs)
   {}
 
-  virtual T operator()(const Edge& edge, idx time) const override
+  T operator()(const Edge& edge, idx time) const override final
   {
     return costs(edge);
   }
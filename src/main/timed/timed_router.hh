@@ -123,26 +123,31 @@ public:
    * @tparam Filter  A filter given by a function mapping from Edge%s
    *                 to boolean values
    * @tparam bounded Whether or not to respect the given bound value.
+   * @tparam Costs   The type of the cost function. Passing the concrete
+   *                 type of a cost function with a final call operator
+   *                 allows the costs to be inlined into the search.
    **/
-  template<class Filter = AllEdgeFilter, bool bounded = false>
+  template<class Filter = AllEdgeFilter,
+           bool bounded = false,
+           class Costs = TimedEdgeFunc<num>>
   SearchResult<> shortestPath(Vertex source,
                               Vertex target,
-                              const TimedEdgeFunc<num>& costs,
+                              const Costs& costs,
                               idx departureTime = 0,
                               const Filter& filter = Filter(),
                               num bound = inf);
 };
 
 
-template<class Filter, bool bounded>
+template<class Filter, bool bounded, class Costs>
 SearchResult<> TimedDijkstra::shortestPath(Vertex source,
                                            Vertex target,
-                                           const TimedEdgeFunc<num>& costs,
+                                           const Costs& costs,
                                            idx departureTime,
                                            const Filter& filter,
                                            num bound)
 {
-  LabelHeap<Label<>> heap(graph);
+  RadixLabelHeap<Label<>> heap(graph);
   int settled = 0, labeled = 0;
   bool found = false;
 
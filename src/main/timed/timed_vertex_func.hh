@@ -1,6 +1,10 @@
 #ifndef TIMED_VERTEX_FUNC_HH
 #define TIMED_VERTEX_FUNC_HH
 
+#include <stdexcept>
+
+#include "span.hh"
+
 #include "graph/graph.hh"
 
 #include "graph/vertex_map.hh"
@@ -34,6 +38,29 @@ class TimedBiVertexFunc
 {
 public:
   virtual T operator()(const Vertex& source, const Vertex& target, idx departureTime) = 0;
+
+  /**
+   * Evaluates the function from the given source to each of the given
+   * targets at the same departure time, storing the results in the
+   * given values. The default evaluates the targets one by one,
+   * implementations may answer all targets at once.
+   **/
+  virtual void distances(const Vertex& source,
+                         idx departureTime,
+                         Span<const Vertex> targets,
+                         Span<T> values)
+  {
+    if(targets.size() != values.size())
+    {
+      throw std::invalid_argument("Numbers of targets and values differ");
+    }
+
+    for(idx i = 0; i < targets.size(); ++i)
+    {
+      values[i] = (*this)(source, targets[i], departureTime);
+    }
+  }
+
   virtual ~TimedBiVertexFunc() {}
 };
 
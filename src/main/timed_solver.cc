@@ -1,7 +1,11 @@
 #include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <random>
+#include <sstream>
 
 #include <boost/program_options.hpp>
 namespace po = boost::program_options;
@@ -9,6 +13,8 @@ namespace po = boost::program_options;
 
 #include "util.hh"
 #include "log.hh"
+#include "parallel.hh"
+#include "timer.hh"
 
 #include "tour/static/tour_solver.hh"
 
@@ -22,6 +28,7 @@ namespace po = boost::program_options;
 #include "tour/sparse/sparse_program.hh"
 #include "tour/sparse/heuristics/greedy_constructions.hh"
 
+#include "tour/sparse/pricers/sparse_concurrent_pricer.hh"
 #include "tour/sparse/pricers/sparse_stabilizing_pricer.hh"
 
 #include "tour/path/path_based_program.hh"
@@ -34,51 +41,45 @@ namespace po = boost::program_options;
 
 #include "instance.hh"
 
-int main(int argc, char **argv)
+struct SolverOptions
 {
-  logInit();
-
-  po::options_description desc("Allowed options");
-
-  bool solveRelaxation = false;
-  bool initialBound = false;
   std::string formulation;
+  bool solveRelaxation;
+  bool initialBound;
+  bool concurrentPricing;
+  bool batch;
+};
 
-  desc.add_options()
-    ("help", "produce help message")
-    ("seed", po::value<idx>(), "seed")
-    ("formulation", po::value<std::string>(&formulation)->required(), "formulation")
-    ("initial_bound", po::bool_switch(&initialBound)->default_value(false), "use static solution as lower bound")
-    ("relax", po::bool_switch(&solveRelaxation)->default_value(false), "solve relaxation")
-    ("size", po::value<idx>(), "number of vertices");
-
-  po::variables_map vm;
-  po::store(po::command_line_parser(argc, argv)
-            .options(desc).run(),
-            vm);
-
-  po::notify(vm);
-
-  if(vm.count("help"))
-  {
-    std::cout << desc << std::endl;
-    return 1;
-  }
-
-  idx numVertices = 50;
-  idx seed = 0;
+struct SolveResult
+{
+  InstanceInfo info;
+  num staticCost;
+  num initialTourCost;
+  double time;
+  SolutionStats stats;
+  std::string error;
+
+  SolveResult(const InstanceInfo& info)
+    : info(info),
+      staticCost(0),
+      initialTourCost(0),
+      time(0),
+      stats(SolutionStats::empty())
+  {}
+};
+
+/**
+ * Solves the given instance, in batch mode the solver output is
+ * suppressed and the solution statistics are collected. Since
+ * the instances of a batch are solved concurrently, each one
+ * is solved using a single thread.
+ **/
+SolveResult solve(const InstanceInfo& info, const SolverOptions& options)
+{
+  SolveResult result(info);
 
-  if(vm.count("size"))
-  {
-    numVertices = vm["size"].as<idx>();
-  }
+  Timer timer;
 
-  if(vm.count("seed"))
-  {
-    seed = vm["seed"].as<idx>();
-  }
-
-  InstanceInfo info(seed, numVertices);
   Instance instance(info);
 
   TourSolver simpleSolver(instance.graph, instance.staticCosts);
@@ -97,23 +98,31 @@ int main(int argc, char **argv)
   Log(info) << "Costs of initial tour according to timed cost function: "
             << initialTourCost;
 
+  result.staticCost = staticCost;
+  result.initialTourCost = initialTourCost;
+
   Program::Settings settings = Program::Settings();
-  settings.doSolveRelaxation(solveRelaxation);
+  settings.doSolveRelaxation(options.solveRelaxation);
+
+  if(options.batch)
+  {
+    settings.withSolverOutput(false).collectStats().withThreads(1);
+  }
 
   double boundVal = 0.;
 
-  if(!solveRelaxation && initialBound)
+  if(!options.solveRelaxation && options.initialBound)
   {
     boundVal = initialTour.cost(instance.staticCosts);
     Log(info) << "Setting lower bound of " << boundVal
               << " according to initial solution";
   }
 
-  if(formulation == "simple")
+  if(options.formulation == "simple")
   {
     SimpleProgram program(initialTour, instance.timedDistances, settings);
 
-    if(solveRelaxation)
+    if(options.solveRelaxation)
     {
       program.solveRelaxation();
     }
@@ -121,8 +130,10 @@ int main(int argc, char **argv)
     {
       program.solve();
     }
+
+    result.stats = program.getStats();
   }
-  else if(formulation == "sparse")
+  else if(options.formulation == "sparse")
   {
     SparseProgram program(initialTour,
                           instance.timedDistances,
@@ -130,7 +141,12 @@ int main(int argc, char **argv)
                           true,
                           settings);
 
-    if(solveRelaxation)
+    if(options.concurrentPricing)
+    {
+      program.setPricer(SparseConcurrentPricer::createDefault(program).release());
+    }
+
+    if(options.solveRelaxation)
     {
       program.solveRelaxation();
     }
@@ -138,8 +154,10 @@ int main(int argc, char **argv)
     {
       program.solve();
     }
+
+    result.stats = program.getStats();
   }
-  else if(formulation == "path_based")
+  else if(options.formulation == "path_based")
   {
     PathBasedProgram program(initialTour,
                              instance.timedDistances,
@@ -147,7 +165,7 @@ int main(int argc, char **argv)
                              true,
                              settings);
 
-    if(solveRelaxation)
+    if(options.solveRelaxation)
     {
       program.solveRelaxation();
     }
@@ -155,8 +173,326 @@ int main(int argc, char **argv)
     {
       program.solve();
     }
+
+    result.stats = program.getStats();
+  }
+  else
+  {
+    throw std::invalid_argument("Unknown formulation: " + options.formulation);
+  }
+
+  result.time = timer.elapsed();
+
+  return result;
+}
+
+/**
+ * Reads a list of instances, one per line given by the number
+ * of vertices and the seed. Empty lines and lines starting
+ * with '#' are skipped.
+ **/
+std::vector<InstanceInfo> readInstances(const std::string& filename)
+{
+  std::ifstream input(filename);
+
+  if(!input)
+  {
+    throw std::invalid_argument("Could not open instance list " + filename);
+  }
+
+  std::vector<InstanceInfo> infos;
+  std::string line;
+
+  while(std::getline(input, line))
+  {
+    if(line.empty() or line[0] == '#')
+    {
+      continue;
+    }
+
+    std::istringstream lineInput(line);
+
+    idx numVertices, seed;
+
+    if(!(lineInput >> numVertices >> seed))
+    {
+      throw std::invalid_argument("Invalid instance line: " + line);
+    }
+
+    infos.push_back(InstanceInfo(seed, numVertices));
+  }
+
+  return infos;
+}
+
+std::string jsonString(const std::string& value)
+{
+  std::ostringstream out;
+
+  out << '"';
+
+  for(const char c : value)
+  {
+    switch(c)
+    {
+    case '"':
+      out << "\\\"";
+      break;
+    case '\\':
+      out << "\\\\";
+      break;
+    case '\n':
+      out << "\\n";
+      break;
+    default:
+      if((unsigned char) c < 0x20)
+      {
+        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int) c
+            << std::dec << std::setfill(' ');
+      }
+      else
+      {
+        out << c;
+      }
+    }
+  }
+
+  out << '"';
+
+  return out.str();
+}
+
+std::string jsonNumber(double value)
+{
+  if(!std::isfinite(value))
+  {
+    return "null";
+  }
+
+  std::ostringstream out;
+  out << std::setprecision(17) << value;
+  return out.str();
+}
+
+void writeCSVHeader(std::ostream& out)
+{
+  out << "Size;Seed;formulation;status;staticCost;initialTourCost;Time;"
+      << "primalBound;dualBound;gap;numNodes;numIterations;"
+      << "numVariables;numConstraints;numCuts"
+      << std::endl;
+}
+
+void writeCSV(std::ostream& out,
+              const SolveResult& result,
+              const SolverOptions& options)
+{
+  const SolutionStats& stats = result.stats;
+
+  out << result.info.numVertices
+      << ";"
+      << result.info.seed
+      << ";"
+      << options.formulation
+      << ";"
+      << (result.error.empty() ? "ok" : "error")
+      << ";"
+      << result.staticCost
+      << ";"
+      << result.initialTourCost
+      << ";"
+      << result.time
+      << ";"
+      << stats.primalBound
+      << ";"
+      << stats.dualBound
+      << ";"
+      << stats.gap
+      << ";"
+      << stats.numNodes
+      << ";"
+      << stats.numIterations
+      << ";"
+      << stats.numVariables
+      << ";"
+      << stats.numConstraints
+      << ";"
+      << stats.numCuts
+      << std::endl;
+}
+
+void writeJSON(std::ostream& out,
+               const SolveResult& result,
+               const SolverOptions& options)
+{
+  const SolutionStats& stats = result.stats;
+
+  out << "{\"size\": " << result.info.numVertices
+      << ", \"seed\": " << result.info.seed
+      << ", \"formulation\": " << jsonString(options.formulation)
+      << ", \"status\": " << jsonString(result.error.empty() ? "ok" : "error");
+
+  if(!result.error.empty())
+  {
+    out << ", \"error\": " << jsonString(result.error);
+  }
+
+  out << ", \"staticCost\": " << result.staticCost
+      << ", \"initialTourCost\": " << result.initialTourCost
+      << ", \"time\": " << jsonNumber(result.time)
+      << ", \"primalBound\": " << jsonNumber(stats.primalBound)
+      << ", \"dualBound\": " << jsonNumber(stats.dualBound)
+      << ", \"gap\": " << jsonNumber(stats.gap)
+      << ", \"numNodes\": " << stats.numNodes
+      << ", \"numIterations\": " << stats.numIterations
+      << ", \"numVariables\": " << stats.numVariables
+      << ", \"numConstraints\": " << stats.numConstraints
+      << ", \"numCuts\": " << stats.numCuts
+      << "}"
+      << std::endl;
+}
+
+/**
+ * Solves the given instances on a pool of worker threads, each of
+ * which runs one solver at a time. The results are written
+ * as soon as they are available, i.e., in the order of completion.
+ * Failing instances are reported rather than aborting the batch.
+ **/
+void solveBatch(const std::vector<InstanceInfo>& infos,
+                const SolverOptions& options,
+                idx numThreads,
+                bool json)
+{
+  std::mutex outputMutex;
+
+  if(!json)
+  {
+    writeCSVHeader(std::cout);
+  }
+
+  parallelFor(infos.size(),
+              [&](idx i)
+              {
+                SolveResult result(infos[i]);
+
+                try
+                {
+                  result = solve(infos[i], options);
+                }
+                catch(const std::exception& exception)
+                {
+                  Log(error) << "Failed to solve instance of size "
+                             << infos[i].numVertices << " with seed "
+                             << infos[i].seed << ": " << exception.what();
+
+                  result.error = exception.what();
+                }
+
+                std::lock_guard<std::mutex> guard(outputMutex);
+
+                if(json)
+                {
+                  writeJSON(std::cout, result, options);
+                }
+                else
+                {
+                  writeCSV(std::cout, result, options);
+                }
+              },
+              numThreads);
+}
+
+int main(int argc, char **argv)
+{
+  logInit();
+
+  po::options_description desc("Allowed options");
+
+  SolverOptions options{"", false, false, false, false};
+  std::string outputFormat;
+
+  desc.add_options()
+    ("help", "produce help message")
+    ("seed", po::value<idx>(), "seed")
+    ("formulation", po::value<std::string>(&options.formulation)->required(), "formulation")
+    ("initial_bound", po::bool_switch(&options.initialBound)->default_value(false), "use static solution as lower bound")
+    ("relax", po::bool_switch(&options.solveRelaxation)->default_value(false), "solve relaxation")
+    ("concurrent_pricing", po::bool_switch(&options.concurrentPricing)->default_value(false), "run several sparse pricers concurrently")
+    ("size", po::value<idx>(), "number of vertices")
+    ("instances", po::value<std::string>(), "batch mode: file listing one instance per line as: size seed")
+    ("num_seeds", po::value<idx>(), "batch mode: solve instances of the given size for this many seeds, starting at the given seed")
+    ("threads", po::value<idx>()->default_value(defaultNumThreads()), "batch mode: number of concurrent solves")
+    ("output_format", po::value<std::string>(&outputFormat)->default_value("csv"), "batch mode: output format (csv or json)");
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv)
+            .options(desc).run(),
+            vm);
+
+  if(vm.count("help"))
+  {
+    std::cout << desc << std::endl;
+    return 1;
+  }
+
+  po::notify(vm);
+
+  if(options.formulation != "simple" and
+     options.formulation != "sparse" and
+     options.formulation != "path_based")
+  {
+    std::cerr << "Unknown formulation: " << options.formulation << std::endl;
+    return 1;
+  }
+
+  if(outputFormat != "csv" and outputFormat != "json")
+  {
+    std::cerr << "Unknown output format: " << outputFormat << std::endl;
+    return 1;
+  }
+
+  idx numVertices = 50;
+  idx seed = 0;
+
+  if(vm.count("size"))
+  {
+    numVertices = vm["size"].as<idx>();
+  }
+
+  if(vm.count("seed"))
+  {
+    seed = vm["seed"].as<idx>();
+  }
+
+  options.batch = vm.count("instances") or vm.count("num_seeds");
+
+  if(!options.batch)
+  {
+    solve(InstanceInfo(seed, numVertices), options);
+
+    return 0;
+  }
+
+  std::vector<InstanceInfo> infos;
+
+  if(vm.count("instances"))
+  {
+    infos = readInstances(vm["instances"].as<std::string>());
+  }
+
+  if(vm.count("num_seeds"))
+  {
+    const idx numSeeds = vm["num_seeds"].as<idx>();
+
+    for(idx i = 0; i < numSeeds; ++i)
+    {
+      infos.push_back(InstanceInfo(seed + i, numVertices));
+    }
   }
 
+  solveBatch(infos,
+             options,
+             vm["threads"].as<idx>(),
+             outputFormat == "json");
 
   return 0;
 }
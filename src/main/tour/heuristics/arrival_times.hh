@@ -0,0 +1,152 @@
+#ifndef ARRIVAL_TIMES_HH
+#define ARRIVAL_TIMES_HH
+
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+#include "tour/tour.hh"
+
+/**
+ * The arrival times along a tour with respect to a TourEvaluator,
+ * departing from the first vertex at time zero. Moves which replace
+ * a range of positions are evaluated by reusing the arrival times
+ * of the unchanged prefix. The suffix is only re-evaluated until
+ * its arrival times agree with the current ones again, since the
+ * remainder of the tour is unchanged from then on.
+ **/
+template<class T = num>
+class ArrivalTimes
+{
+private:
+  const TourEvaluator<T>& evaluator;
+  std::vector<Vertex> vertices;
+
+  // times[i] is the arrival time at vertices[i], times[size] is the
+  // arrival time back at the first vertex, i.e., the cost of the tour
+  std::vector<T> times;
+
+public:
+  ArrivalTimes(const TourEvaluator<T>& evaluator,
+               const std::vector<Vertex>& vertices)
+    : evaluator(evaluator)
+  {
+    reset(vertices);
+  }
+
+  /**
+   * Recomputes the arrival times for the given tour vertices.
+   **/
+  void reset(const std::vector<Vertex>& nextVertices)
+  {
+    vertices = nextVertices;
+
+    const idx size = vertices.size();
+
+    times.assign(size + 1, 0);
+
+    if(size <= 1)
+    {
+      return;
+    }
+
+    for(idx i = 1; i <= size; ++i)
+    {
+      const Vertex& target = (i == size) ? vertices[0] : vertices[i];
+
+      times[i] = times[i - 1] + evaluator.travelTime(vertices[i - 1],
+                                                     target,
+                                                     times[i - 1]);
+    }
+  }
+
+  T cost() const
+  {
+    return times.back();
+  }
+
+  T arrivalTime(idx position) const
+  {
+    assert(position <= vertices.size());
+    return times[position];
+  }
+
+  /**
+   * Returns the cost of the tour obtained by replacing the vertices
+   * at the positions [begin, end) by the (equally many) vertices
+   * in [first, last).
+   **/
+  template <class It>
+  T evaluate(idx begin, idx end, It first, It last) const
+  {
+    return evaluateMove<false>(begin, end, first, last);
+  }
+
+  /**
+   * As evaluate(), but assumes travel times satisfying the FIFO
+   * property: Arriving at a vertex of the unchanged suffix no earlier
+   * than before, the remaining tour cannot be traversed any faster.
+   * In this case the current cost is returned immediately, i.e.,
+   * the result is exact for improving moves only.
+   **/
+  template <class It>
+  T evaluateFIFO(idx begin, idx end, It first, It last) const
+  {
+    return evaluateMove<true>(begin, end, first, last);
+  }
+
+private:
+  template <bool fifo, class It>
+  T evaluateMove(idx begin, idx end, It first, It last) const
+  {
+    const idx size = vertices.size();
+
+    assert(begin <= end && end <= size);
+    assert(std::distance(first, last) == (std::ptrdiff_t) (end - begin));
+
+    if(size <= 1 or begin == end)
+    {
+      return cost();
+    }
+
+    const Vertex source = (begin == 0) ? *first : vertices[0];
+
+    // The final leg leads back to the source, if the source changes,
+    // the suffix must be evaluated in full
+    const bool sameSource = (source == vertices[0]);
+
+    Vertex current = source;
+    T time = 0;
+
+    if(begin == 0)
+    {
+      ++first;
+    }
+    else
+    {
+      current = vertices[begin - 1];
+      time = times[begin - 1];
+    }
+
+    for(; first != last; ++first)
+    {
+      time += evaluator.travelTime(current, *first, time);
+      current = *first;
+    }
+
+    for(idx i = end; i < size; ++i)
+    {
+      time += evaluator.travelTime(current, vertices[i], time);
+      current = vertices[i];
+
+      if(sameSource and (fifo ? (time >= times[i]) : (time == times[i])))
+      {
+        return cost();
+      }
+    }
+
+    return time + evaluator.travelTime(current, source, time);
+  }
+};
+
+#endif /* ARRIVAL_TIMES_HH */
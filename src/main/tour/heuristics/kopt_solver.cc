@@ -1,12 +1,16 @@
 #include "kopt_solver.hh"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <iterator>
+#include <mutex>
 #include <sstream>
 
 #include "log.hh"
 
+#include "arrival_times.hh"
+
 namespace
 {
   typedef std::vector<Vertex>::const_iterator VertexIterator;
@@ -45,7 +49,7 @@ namespace
     return slices;
   }
 
-  MultiIterator createMultiIterator(std::vector<Vertex>& vertices,
+  MultiIterator createMultiIterator(const std::vector<Vertex>& vertices,
                                     num k,
                                     KOptSolver::DifferenceType initialDistance)
   {
@@ -120,6 +124,89 @@ namespace
     return false;
   }
 
+  /**
+   * Finds the first improving move whose first slice begins at the
+   * given distance, enumerating moves in the same order as a
+   * sequential scan. Gives up once a move with a smaller distance
+   * has been found (i.e., found < chunk).
+   **/
+  bool findMove(const ArrivalTimes<>& arrivalTimes,
+                const std::vector<Vertex>& tourVertices,
+                idx k,
+                KOptSolver::DifferenceType distance,
+                idx chunk,
+                const std::atomic<idx>& found,
+                std::vector<Vertex>& middleVertices,
+                num& cost)
+  {
+    const num initialCost = arrivalTimes.cost();
+
+    MultiIterator multiIterator = createMultiIterator(tourVertices,
+                                                      k,
+                                                      distance);
+
+    const VertexIterator first = *(multiIterator.begin());
+    const VertexIterator begin = tourVertices.begin();
+
+    const idx firstPosition = std::distance(begin, first);
+
+    assert(firstPosition > 0);
+
+    // The vertices replacing the range [first, last), the
+    // buffer is reused by all moves evaluated on the same thread
+    middleVertices.reserve(tourVertices.size());
+
+    const std::uint64_t minInverter = 1;
+    const std::uint64_t maxInverter = 1 << k;
+
+    do {
+
+      if(found < chunk)
+      {
+        return false;
+      }
+
+      const VertexIterator last = *(multiIterator.rbegin());
+
+      const idx lastPosition = std::distance(begin, last);
+
+      std::vector<Slice> slices = createSlices(multiIterator);
+
+      do {
+        for(std::uint64_t curr = minInverter; curr < maxInverter; ++curr)
+        {
+          middleVertices.resize(0);
+
+          insertSlices(slices, curr, middleVertices);
+
+          assert(middleVertices.size() == lastPosition - firstPosition);
+
+          const num nextCost = arrivalTimes.evaluate(firstPosition,
+                                                     lastPosition,
+                                                     middleVertices.begin(),
+                                                     middleVertices.end());
+
+          if(nextCost < initialCost)
+          {
+            cost = nextCost;
+            return true;
+          }
+        }
+      } while(std::next_permutation(slices.begin(), slices.end(), SliceComparator{}));
+
+      /*
+      if(debuggingEnabled())
+      {
+        printMultiIterator(multiIterator, tourVertices);
+      }
+      */
+    }
+    while(advanceMultiIterator(multiIterator, tourVertices.end()) and
+          *(multiIterator.begin()) == first);
+
+    return false;
+  }
+
   /*
   void printMultiIterator(const MultiIterator& multiIterator,
                           const std::vector<Vertex>& vertices)
@@ -144,10 +231,12 @@ namespace
 
 KOptSolver::KOptSolver(const Graph& graph,
                        const std::vector<Vertex>& vertices,
-                       const idx k)
+                       const idx k,
+                       idx numThreads)
   : graph(graph),
     vertices(vertices),
-    k(k)
+    k(k),
+    numThreads(std::max(numThreads, (idx) 1))
 {
   if(vertices.size() < k or k > 64)
   {
@@ -169,9 +258,11 @@ Tour KOptSolver::findTour(TourEvaluator<>& evaluator,
 
   DifferenceType difference = 1;
 
+  ThreadPool pool(numThreads);
+
   do
   {
-    difference = improve(evaluator, currentTour, difference);
+    difference = improve(evaluator, currentTour, difference, pool);
   }
   while(difference != (DifferenceType) -1);
 
@@ -187,76 +278,83 @@ Tour KOptSolver::findTour(TourEvaluator<>& evaluator,
 KOptSolver::DifferenceType
 KOptSolver::improve(TourEvaluator<>& evaluator,
                     Tour& tour,
-                    DifferenceType initialDistance)
+                    DifferenceType initialDistance,
+                    ThreadPool& pool)
 {
   std::vector<Vertex>& tourVertices = tour.getVertices();
 
-  const num initialCost = evaluator(tour);
-
   if(tourVertices.size() < k)
   {
     throw std::invalid_argument("Tour has too few vertices");
   }
 
-  MultiIterator multiIterator = createMultiIterator(tourVertices,
-                                                    k,
-                                                    initialDistance);
-
-  Tour nextTour(graph, tourVertices);
-  std::vector<Vertex>& nextVertices = nextTour.getVertices();
-  nextVertices.reserve(tourVertices.size());
-
-  const std::uint64_t minInverter = 1;
-  const std::uint64_t maxInverter = 1 << k;
-
-  do {
-
-    const VertexIterator first = *(multiIterator.begin());
-    const VertexIterator last = *(multiIterator.rbegin());
-
-    const VertexIterator begin = tourVertices.begin();
-    const VertexIterator end = tourVertices.end();
-
-    std::vector<Slice> slices = createSlices(multiIterator);
-
-    do {
-      for(std::uint64_t curr = minInverter; curr < maxInverter; ++curr)
-      {
-        nextVertices.resize(0);
-
-        nextVertices.insert(nextVertices.end(), begin, first);
-
-        insertSlices(slices, curr, nextVertices);
+  const ArrivalTimes<> arrivalTimes(evaluator, tourVertices);
 
-        nextVertices.insert(nextVertices.end(), last, end);
+  const DifferenceType maxDistance = tourVertices.size() - k;
 
-        assert(nextVertices.size() == tourVertices.size());
-
-        const num nextCost = evaluator(nextTour);
-        const num costDifference = nextCost - initialCost;
+  if(initialDistance > maxDistance)
+  {
+    return (DifferenceType) -1;
+  }
 
-        assert(*nextVertices.begin() == *vertices.begin());
+  // Moves are split into chunks by the position of their first
+  // slice. The first improving move of the first chunk containing
+  // one is the one found by a sequential scan.
+  const idx numChunks = maxDistance - initialDistance + 1;
+
+  // One buffer per thread, only the best move found so far is kept
+  std::vector<std::vector<Vertex>> buffers(pool.numThreads());
+
+  std::mutex bestMutex;
+  idx bestChunk = numChunks;
+  std::vector<Vertex> bestVertices;
+  num bestCost = 0;
+
+  const idx chunk = parallelFindFirst(pool,
+                                      numChunks,
+                                      [&](idx chunk, const std::atomic<idx>& found) -> bool
+                                      {
+                                        std::vector<Vertex>& buffer = buffers[pool.threadIndex()];
+                                        num cost;
+
+                                        if(!findMove(arrivalTimes,
+                                                     tourVertices,
+                                                     k,
+                                                     initialDistance + chunk,
+                                                     chunk,
+                                                     found,
+                                                     buffer,
+                                                     cost))
+                                        {
+                                          return false;
+                                        }
+
+                                        std::lock_guard<std::mutex> guard(bestMutex);
+
+                                        if(chunk < bestChunk)
+                                        {
+                                          bestChunk = chunk;
+                                          bestVertices = buffer;
+                                          bestCost = cost;
+                                        }
+
+                                        return true;
+                                      });
+
+  if(chunk == numChunks)
+  {
+    return (DifferenceType) -1;
+  }
 
-        if(costDifference < 0)
-        {
-          DifferenceType distance = std::distance(begin, *(multiIterator.begin()));
-          Log(info) << "Cost decreased by " << -costDifference;
-          tourVertices = nextVertices;
+  assert(chunk == bestChunk);
 
-          return distance;
-        }
+  const DifferenceType distance = initialDistance + chunk;
 
-      }
-    } while(std::next_permutation(slices.begin(), slices.end(), SliceComparator{}));
+  Log(info) << "Cost decreased by " << arrivalTimes.cost() - bestCost;
 
-    /*
-    if(debuggingEnabled())
-    {
-      printMultiIterator(multiIterator, tourVertices);
-    }
-    */
-  }
-  while (advanceMultiIterator(multiIterator, tourVertices.end()));
+  std::copy(bestVertices.begin(),
+            bestVertices.end(),
+            tourVertices.begin() + distance);
 
-  return (DifferenceType) -1;
+  return distance;
 }
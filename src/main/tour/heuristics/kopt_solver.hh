@@ -7,6 +7,16 @@
 
 #include "tour/tour.hh"
 
+#include "parallel.hh"
+
+/**
+ * A k-opt local search. The moves of each step can be evaluated
+ * in parallel by threads which are reused across all steps. Each
+ * step performs the first improving move with respect to a sequential
+ * scan, the result does not depend on the number of threads. More
+ * than one thread requires an evaluator supporting concurrent queries,
+ * which a DistanceEvaluator sharing a single Router does not.
+ **/
 class KOptSolver
 {
 public:
@@ -16,15 +26,18 @@ private:
   const Graph& graph;
   const std::vector<Vertex> vertices;
   const idx k;
+  const idx numThreads;
 
   DifferenceType improve(TourEvaluator<>& evaluator,
                          Tour& tour,
-                         DifferenceType initialDistance);
+                         DifferenceType initialDistance,
+                         ThreadPool& pool);
 
 public:
   KOptSolver(const Graph& graph,
              const std::vector<Vertex>& vertices,
-             const idx k);
+             const idx k,
+             idx numThreads = 1);
 
   Tour findTour(TourEvaluator<>& evaluator,
                 const Tour& initialTour);
@@ -1,9 +1,12 @@
 #include "three_opt_solver.hh"
 
+#include <algorithm>
 #include <iterator>
 
 #include "log.hh"
 
+#include "arrival_times.hh"
+
 ThreeOptSolver::ThreeOptSolver(const Graph& graph,
                                const std::vector<Vertex>& vertices)
   : graph(graph),
@@ -28,12 +31,27 @@ void ThreeOptSolver::improve(TourEvaluator<>& evaluator,
   const idx size = vertices.size();
 
   auto begin = tour.getVertices().begin();
-  auto end = tour.getVertices().end();
 
-  num currentCost = evaluator(tour);
+  ArrivalTimes<> arrivalTimes(evaluator, tour.getVertices());
+
+  num currentCost = arrivalTimes.cost();
 
   Log(info) << "Cost of initial tour: " << currentCost;
 
+  // The vertices replacing the range [first, third)
+  std::vector<Vertex> middleVertices;
+  middleVertices.reserve(size);
+
+  auto applyMove = [&](num cost)
+    {
+      Log(info) << "Found improvement, new tour cost: " << cost;
+      std::copy(std::begin(middleVertices),
+                std::end(middleVertices),
+                first);
+      arrivalTimes.reset(tour.getVertices());
+      currentCost = cost;
+    };
+
   for(; first != tour.getVertices().end(); ++first)
   {
     auto second = first;
@@ -53,84 +71,58 @@ void ThreeOptSolver::improve(TourEvaluator<>& evaluator,
         // third slice: [second, third)
         // last slice: [third, end)
 
-        std::vector<Vertex> firstVertices;
-        firstVertices.reserve(size);
+        // The first and last slices are unchanged by all moves
+        const idx firstPosition = std::distance(begin, first);
+        const idx thirdPosition = std::distance(begin, third);
 
-        firstVertices.insert(std::end(firstVertices), begin, first);
-        firstVertices.insert(std::end(firstVertices), second, third);
-        firstVertices.insert(std::end(firstVertices),
-                             std::reverse_iterator<decltype(second)>(second),
-                             std::reverse_iterator<decltype(first)>(first));
-        firstVertices.insert(std::end(firstVertices),
-                             third, end);
-
-        assert(firstVertices.size() == size);
-
-        Tour firstTour(graph, firstVertices);
+        middleVertices.clear();
+        middleVertices.insert(std::end(middleVertices), second, third);
+        middleVertices.insert(std::end(middleVertices),
+                              std::reverse_iterator<decltype(second)>(second),
+                              std::reverse_iterator<decltype(first)>(first));
 
-        const num firstCost = evaluator(firstTour);
+        const num firstCost = arrivalTimes.evaluate(firstPosition,
+                                                    thirdPosition,
+                                                    std::begin(middleVertices),
+                                                    std::end(middleVertices));
 
         if(firstCost < currentCost)
         {
-          Log(info) << "Found improvement, new tour cost: " << firstCost;
-          std::copy(std::begin(firstVertices),
-                    std::end(firstVertices),
-                    std::begin(tour.getVertices()));
-          currentCost = firstCost;
+          applyMove(firstCost);
           break;
         }
 
-        std::vector<Vertex> secondVertices;
-        secondVertices.reserve(size);
-
-        secondVertices.insert(std::end(secondVertices), begin, first);
-        secondVertices.insert(std::end(secondVertices),
+        middleVertices.clear();
+        middleVertices.insert(std::end(middleVertices),
                               std::reverse_iterator<decltype(third)>(third),
                               std::reverse_iterator<decltype(second)>(second));
-        secondVertices.insert(std::end(secondVertices),
+        middleVertices.insert(std::end(middleVertices),
                               std::reverse_iterator<decltype(second)>(second),
                               std::reverse_iterator<decltype(first)>(first));
 
-        secondVertices.insert(std::end(secondVertices), third, end);
-
-        assert(secondVertices.size() == size);
-
-        Tour secondTour(graph, secondVertices);
-
-        const num secondCost = evaluator(secondTour);
+        const num secondCost = arrivalTimes.evaluate(firstPosition,
+                                                     thirdPosition,
+                                                     std::begin(middleVertices),
+                                                     std::end(middleVertices));
 
         if(secondCost < currentCost)
         {
-          Log(info) << "Found improvement, new tour cost: " << secondCost;
-          std::copy(std::begin(secondVertices),
-                    std::end(secondVertices),
-                    std::begin(tour.getVertices()));
-          currentCost = secondCost;
+          applyMove(secondCost);
           break;
         }
 
-        std::vector<Vertex> thirdVertices;
-        thirdVertices.reserve(size);
-
-        thirdVertices.insert(std::end(thirdVertices), begin, first);
-        thirdVertices.insert(std::end(thirdVertices), second, third);
-        thirdVertices.insert(std::end(thirdVertices), first, second);
-
-        thirdVertices.insert(std::end(thirdVertices), third, end);
-
-        assert(thirdVertices.size() == size);
-
-        Tour thirdTour(graph, thirdVertices);
+        middleVertices.clear();
+        middleVertices.insert(std::end(middleVertices), second, third);
+        middleVertices.insert(std::end(middleVertices), first, second);
 
-        const num thirdCost = evaluator(thirdTour);
+        const num thirdCost = arrivalTimes.evaluate(firstPosition,
+                                                    thirdPosition,
+                                                    std::begin(middleVertices),
+                                                    std::end(middleVertices));
 
         if(thirdCost < currentCost)
         {
-          Log(info) << "Found improvement, new tour cost: " << thirdCost;
-          std::copy(std::begin(thirdVertices),
-                    std::end(thirdVertices),
-                    std::begin(tour.getVertices()));
-          currentCost = thirdCost;
+          applyMove(thirdCost);
           break;
         }
       }
@@ -1,9 +1,12 @@
 #include "two_opt_solver.hh"
 
+#include <algorithm>
 #include <iterator>
 
 #include "log.hh"
 
+#include "arrival_times.hh"
+
 TwoOptSolver::TwoOptSolver(const Graph& graph,
                            const std::vector<Vertex>& vertices)
   : graph(graph),
@@ -30,53 +33,50 @@ Tour TwoOptSolver::findTour(TourEvaluator<>& evaluator, const Tour& initialTour)
 TwoOptSolver::DifferenceType
 TwoOptSolver::improve(Tour& tour, TourEvaluator<>& evaluator, DifferenceType difference)
 {
-  const num initialCost = evaluator(tour);
+  std::vector<Vertex>& tourVertices = tour.getVertices();
+
+  const ArrivalTimes<> arrivalTimes(evaluator, tourVertices);
+
+  const num initialCost = arrivalTimes.cost();
   Log(info) << "Initial cost: " << initialCost;
 
-  std::vector<Vertex>::iterator first = tour.getVertices().begin();
+  const auto begin = tourVertices.begin();
+  const auto end = tourVertices.end();
 
-  std::advance(first, difference);
+  auto first = begin;
 
-  Tour nextTour(graph, vertices);
+  std::advance(first, difference);
 
-  for(; first != tour.getVertices().end(); ++first)
+  for(; first != end; ++first)
   {
     auto second = first;
     ++second;
 
-    if(second == tour.getVertices().end())
+    if(second == end)
     {
       continue;
     }
 
-    for(; second != tour.getVertices().end(); ++second)
-    {
-      std::vector<Vertex>& nextVertices = nextTour.getVertices();
-      nextVertices.resize(0);
-
-      nextVertices.insert(std::end(nextVertices),
-                          tour.getVertices().begin(),
-                          first);
-
-      nextVertices.insert(std::end(nextVertices),
-                          std::reverse_iterator<decltype(second)>(second),
-                          std::reverse_iterator<decltype(first)>(first));
-
-      nextVertices.insert(std::end(nextVertices),
-                          second,
-                          tour.getVertices().end());
+    const idx firstPosition = std::distance(begin, first);
 
-      assert(nextVertices.size() == vertices.size());
-
-      num nextCost = evaluator(nextTour);
+    for(; second != end; ++second)
+    {
+      // Only the reversed range [first, second) and the
+      // suffix following it need to be re-evaluated
+      num nextCost = arrivalTimes.evaluate(firstPosition,
+                                           std::distance(begin, second),
+                                           std::reverse_iterator<decltype(second)>(second),
+                                           std::reverse_iterator<decltype(first)>(first));
 
       num costDifference = nextCost - initialCost;
 
       if(costDifference < 0)
       {
-        DifferenceType dist = std::distance(tour.getVertices().begin(), first);
+        DifferenceType dist = firstPosition;
+
+        std::reverse(first, second);
 
-        tour.getVertices() = nextVertices;
+        assert(tourVertices.size() == vertices.size());
 
         Log(info) << "Found a 2-opt step, cost decreased to " << nextCost;
 
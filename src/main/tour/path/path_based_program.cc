@@ -26,7 +26,11 @@ PathBasedProgram::PathBasedProgram(const Tour& initialTour,
     initialTour(initialTour),
     source(initialTour.getSource()),
     originalGraph(initialTour.getGraph()),
-    graph(createTimeExpandedGraph(initialTour, distances, lowerBound)),
+    graph(createCachedTimeExpandedGraph(initialTour,
+                                        distances,
+                                        settings.graphCacheFile,
+                                        lowerBound,
+                                        settings.numThreads)),
     timeHorizon(initialTour.cost(distances)),
     pricer(nullptr),
     combinedVariables(graph, nullptr),
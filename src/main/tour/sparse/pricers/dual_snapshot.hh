@@ -0,0 +1,128 @@
+#ifndef DUAL_SNAPSHOT_HH
+#define DUAL_SNAPSHOT_HH
+
+#include <memory>
+
+#include "scip_utils.hh"
+
+#include "graph/edge_map.hh"
+#include "graph/edge_set.hh"
+#include "graph/vertex_map.hh"
+
+/**
+ * An immutable snapshot of the dual solution of the current LP,
+ * which is taken by the SparsePricingManager once per pricing round.
+ * Pricers consume the snapshot rather than querying SCIP themselves,
+ * so they do not depend on the state of SCIP while they run.
+ *
+ * Snapshots share their data, copies are cheap.
+ **/
+class DualSnapshot
+{
+private:
+  struct Data
+  {
+    DualCostType costType;
+    EdgeMap<double> dualValues;
+    EdgeMap<double> reducedCosts;
+    EdgeMap<double> variableReducedCosts;
+    VertexMap<double> coveringDuals;
+    EdgeSet forbiddenEdges;
+    double objectiveValue;
+    double lowerBound;
+    double upperBound;
+  };
+
+  std::shared_ptr<const Data> data;
+
+public:
+  /**
+   * @param dualValues     The dual costs of the timed edges, combining the
+   *                       duals of linking, flow and separated constraints
+   * @param reducedCosts   The reduced costs of the timed edges with respect
+   *                       to the dual values, stored contiguously
+   * @param variableReducedCosts The reduced costs of the variables of the
+   *                       timed edges in the current LP
+   * @param coveringDuals  The duals of the covering constraints
+   * @param forbiddenEdges The underlying edges fixed to zero
+   * @param objectiveValue The objective value of the current LP
+   * @param lowerBound     The global lower bound on the tour duration
+   * @param upperBound     The global upper bound on the tour duration
+   **/
+  DualSnapshot(DualCostType costType,
+               EdgeMap<double>&& dualValues,
+               EdgeMap<double>&& reducedCosts,
+               EdgeMap<double>&& variableReducedCosts,
+               VertexMap<double>&& coveringDuals,
+               EdgeSet&& forbiddenEdges,
+               double objectiveValue,
+               double lowerBound,
+               double upperBound)
+    : data(new Data{costType,
+                    std::move(dualValues),
+                    std::move(reducedCosts),
+                    std::move(variableReducedCosts),
+                    std::move(coveringDuals),
+                    std::move(forbiddenEdges),
+                    objectiveValue,
+                    lowerBound,
+                    upperBound})
+  {}
+
+  DualCostType getCostType() const
+  {
+    return data->costType;
+  }
+
+  const EdgeMap<double>& getDualValues() const
+  {
+    return data->dualValues;
+  }
+
+  /**
+   * The reduced costs of the timed edges, i.e., the travel times minus
+   * the dual values for SIMPLE and the negative dual values for FARKAS
+   * pricing.
+   **/
+  const EdgeMap<double>& getReducedCosts() const
+  {
+    return data->reducedCosts;
+  }
+
+  /**
+   * The reduced costs of the variables of the timed edges as reported
+   * by SCIP. The values are zero for timed edges without variables
+   * and for FARKAS pricing.
+   **/
+  const EdgeMap<double>& getVariableReducedCosts() const
+  {
+    return data->variableReducedCosts;
+  }
+
+  const VertexMap<double>& getCoveringDuals() const
+  {
+    return data->coveringDuals;
+  }
+
+  const EdgeSet& getForbiddenEdges() const
+  {
+    return data->forbiddenEdges;
+  }
+
+  double getObjectiveValue() const
+  {
+    return data->objectiveValue;
+  }
+
+  double getLowerBound() const
+  {
+    return data->lowerBound;
+  }
+
+  double getUpperBound() const
+  {
+    return data->upperBound;
+  }
+};
+
+#endif /* DUAL_SNAPSHOT_HH */
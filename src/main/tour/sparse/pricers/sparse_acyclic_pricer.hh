@@ -14,7 +14,7 @@ private:
 public:
   SparseAcyclicPricer(SparseProgram& program);
 
-  virtual std::vector<TimedPath> findPaths(const EdgeFunc<double>& reducedCosts,
+  virtual std::vector<TimedPath> findPaths(const EdgeMap<double>& reducedCosts,
                                            const EdgeSet& forbiddenEdges,
                                            const std::optional<double>& lowerTimeBound,
                                            const std::optional<double>& upperTimeBound,
@@ -29,7 +29,7 @@ SparseAcyclicPricer<size>::SparseAcyclicPricer(SparseProgram& program)
 
 template<idx size>
 std::vector<TimedPath>
-SparseAcyclicPricer<size>::findPaths(const EdgeFunc<double>& reducedCosts,
+SparseAcyclicPricer<size>::findPaths(const EdgeMap<double>& reducedCosts,
                                      const EdgeSet& forbiddenEdges,
                                      const std::optional<double>& lowerTimeBound,
                                      const std::optional<double>& upperTimeBound,
@@ -0,0 +1,96 @@
+#include "sparse_concurrent_pricer.hh"
+
+#include "graph/edge_set.hh"
+
+#include "sparse_edge_pricer.hh"
+#include "sparse_path_router_pricer.hh"
+
+SparseConcurrentPricer::SparseConcurrentPricer(SparseProgram& program,
+                                               std::vector<std::unique_ptr<SparsePricer>>&& pricers,
+                                               idx numThreads)
+  : SparsePricer(program),
+    pricers(std::move(pricers)),
+    numThreads(numThreads)
+{
+}
+
+std::unique_ptr<SparseConcurrentPricer>
+SparseConcurrentPricer::createDefault(SparseProgram& program)
+{
+  std::vector<std::unique_ptr<SparsePricer>> pricers;
+
+  pricers.push_back(std::make_unique<SparseEdgePricer>(program));
+  pricers.push_back(std::make_unique<SparseSimplePathPricer>(program));
+  pricers.push_back(std::make_unique<SparseAcyclicHoleFreePricer<3>>(program));
+
+  return std::make_unique<SparseConcurrentPricer>(program,
+                                                  std::move(pricers),
+                                                  program.getSettings().numThreads);
+}
+
+SparsePricingResult
+SparseConcurrentPricer::merge(const TimeExpandedGraph& graph,
+                              const std::vector<SparsePricingResult>& results)
+{
+  EdgeSet addedEdges(graph);
+
+  std::vector<TimedPath> paths;
+  std::vector<TimedEdge> edges;
+  std::optional<double> lowerBound;
+
+  for(const SparsePricingResult& result : results)
+  {
+    for(const TimedPath& path : result.getPaths())
+    {
+      paths.push_back(path);
+
+      for(const TimedEdge& timedEdge : path.getEdges())
+      {
+        addedEdges.insert(timedEdge);
+      }
+    }
+
+    const std::optional<double> resultBound = result.getLowerBound();
+
+    if(resultBound)
+    {
+      lowerBound = std::max(*resultBound, lowerBound.value_or(*resultBound));
+    }
+  }
+
+  for(const SparsePricingResult& result : results)
+  {
+    for(const TimedEdge& timedEdge : result.getEdges())
+    {
+      if(!addedEdges.contains(timedEdge))
+      {
+        addedEdges.insert(timedEdge);
+        edges.push_back(timedEdge);
+      }
+    }
+  }
+
+  return SparsePricingResult(edges, paths, lowerBound);
+}
+
+SparsePricingResult
+SparseConcurrentPricer::performPricing(const DualSnapshot& snapshot)
+{
+  std::vector<SparsePricingResult> results(pricers.size());
+
+  parallelFor(pricers.size(),
+              [&](idx i)
+              {
+                results[i] = pricers[i]->performPricing(snapshot);
+              },
+              numThreads);
+
+  SparsePricingResult result = merge(graph, results);
+
+  Log(info) << "Merged the results of " << pricers.size()
+            << " pricers into " << result.getPaths().size()
+            << " paths and " << result.getEdges().size()
+            << " edges";
+
+  return result;
+}
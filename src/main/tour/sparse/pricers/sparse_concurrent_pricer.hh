@@ -0,0 +1,49 @@
+#ifndef SPARSE_CONCURRENT_PRICER_HH
+#define SPARSE_CONCURRENT_PRICER_HH
+
+#include <memory>
+#include <vector>
+
+#include "parallel.hh"
+
+#include "sparse_pricer.hh"
+
+/**
+ * A SparsePricer which runs a number of pricers concurrently,
+ * each one on its own thread, and merges their results.
+ *
+ * All pricers share the same DualSnapshot. The problem itself is
+ * only modified afterwards, when the SparsePricingManager adds
+ * the merged result on the calling thread.
+ **/
+class SparseConcurrentPricer : public SparsePricer
+{
+private:
+  std::vector<std::unique_ptr<SparsePricer>> pricers;
+  idx numThreads;
+
+public:
+  SparseConcurrentPricer(SparseProgram& program,
+                         std::vector<std::unique_ptr<SparsePricer>>&& pricers,
+                         idx numThreads = defaultNumThreads());
+
+  /**
+   * Creates a SparseConcurrentPricer running a SparseEdgePricer,
+   * a SparseSimplePathPricer and a SparseAcyclicHoleFreePricer
+   * using the number of threads of the program settings.
+   **/
+  static std::unique_ptr<SparseConcurrentPricer> createDefault(SparseProgram& program);
+
+  /**
+   * Merges the given results: The paths of all results are combined,
+   * edges are only retained if they are not already contained in
+   * any other edge or path. The lower bound is the largest one
+   * among the results.
+   **/
+  static SparsePricingResult merge(const TimeExpandedGraph& graph,
+                                   const std::vector<SparsePricingResult>& results);
+
+  virtual SparsePricingResult performPricing(const DualSnapshot& snapshot) override;
+};
+
+#endif /* SPARSE_CONCURRENT_PRICER_HH */
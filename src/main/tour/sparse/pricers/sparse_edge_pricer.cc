@@ -10,12 +10,15 @@ SparseEdgePricer::SparseEdgePricer(SparseProgram& program,
 }
 
 EdgeMap<std::vector<SparseEdgePricer::Candidate>>
-SparseEdgePricer::findCandidates(const EdgeFunc<double>& reducedCosts,
+SparseEdgePricer::findCandidates(const EdgeMap<double>& reducedCosts,
+                                 const DualSnapshot& snapshot,
                                  std::optional<double>& minReducedCost)
 {
   //createDualCosts();
 
-  EdgeSet forbiddenEdges = program.getForbiddenEdges();
+  const EdgeSet& forbiddenEdges = snapshot.getForbiddenEdges();
+
+  const double* costValues = reducedCosts.data();
 
   uint numCandidates = 0;
 
@@ -33,9 +36,9 @@ SparseEdgePricer::findCandidates(const EdgeFunc<double>& reducedCosts,
 
     for(const TimedEdge& timedEdge : graph.getTimedEdges(edge))
     {
-      const double edgeCost = reducedCosts(timedEdge);
+      const double edgeCost = costValues[timedEdge.getIndex()];
 
-      if(cmp::gt(timedEdge.getTarget().getTime(), program.upperBound()) &&
+      if(cmp::gt(timedEdge.getTarget().getTime(), snapshot.getUpperBound()) &&
          !solveRelaxation)
       {
         continue;
@@ -43,7 +46,7 @@ SparseEdgePricer::findCandidates(const EdgeFunc<double>& reducedCosts,
 
       if(graph.underlyingVertex(timedEdge.getTarget()) == program.getSource())
       {
-        if(cmp::lt(timedEdge.getTarget().getTime(), program.lowerBound()) &&
+        if(cmp::lt(timedEdge.getTarget().getTime(), snapshot.getLowerBound()) &&
            !solveRelaxation)
         {
           continue;
@@ -76,24 +79,13 @@ SparseEdgePricer::findCandidates(const EdgeFunc<double>& reducedCosts,
 }
 
 SparsePricingResult
-SparseEdgePricer::performPricing(DualCostType costType)
+SparseEdgePricer::performPricing(const DualSnapshot& snapshot)
 {
-  EdgeMap<double> dualValues = program.getDualValues(costType);
-
-  EdgeMap<std::vector<Candidate>> candidates;
-
   std::optional<double> minReducedCost;
 
-  if(costType == DualCostType::SIMPLE)
-  {
-    candidates = findCandidates(ReducedCosts(dualValues.getValues(), graph.travelTimes()),
-                                minReducedCost);
-  }
-  else
-  {
-    candidates = findCandidates(FarkasCosts(dualValues.getValues()),
-                                minReducedCost);
-  }
+  EdgeMap<std::vector<Candidate>> candidates = findCandidates(snapshot.getReducedCosts(),
+                                                              snapshot,
+                                                              minReducedCost);
 
   for(const Edge& edge : originalGraph.getEdges())
   {
@@ -130,7 +122,7 @@ SparseEdgePricer::performPricing(DualCostType costType)
   {
     minReducedCost = std::min(*minReducedCost, 0.);
 
-    lowerBound = SCIPgetLPObjval(scip) + (*minReducedCost) * numOriginalVertices;
+    lowerBound = snapshot.getObjectiveValue() + (*minReducedCost) * numOriginalVertices;
   }
   
   Log(info) << "Adding " << edges.size() << " edges";
@@ -27,14 +27,15 @@ private:
 
   idx numEdges;
 
-  EdgeMap<std::vector<Candidate>> findCandidates(const EdgeFunc<double>& costs,
+  EdgeMap<std::vector<Candidate>> findCandidates(const EdgeMap<double>& costs,
+                                                 const DualSnapshot& snapshot,
                                                  std::optional<double>& minReducedCost);
 
 public:
   SparseEdgePricer(SparseProgram& program,
                    idx numEdges = 20);
 
-  virtual SparsePricingResult performPricing(DualCostType costType) override;
+  virtual SparsePricingResult performPricing(const DualSnapshot& snapshot) override;
 };
 
 
@@ -10,10 +10,8 @@ SparsePathPricer::SparsePathPricer(SparseProgram& program,
 }
 
 SparsePricingResult
-SparsePathPricer::performPricing(DualCostType costType)
+SparsePathPricer::performPricing(const DualSnapshot& snapshot)
 {
-  EdgeMap<double> dualValues = program.getDualValues(costType);
-
   std::optional<double> minReducedCost;
 
   std::vector<TimedPath> paths;
@@ -23,30 +21,19 @@ SparsePathPricer::performPricing(DualCostType costType)
   std::optional<double> lowerTimeBound;
   std::optional<double> upperTimeBound;
 
-  const EdgeSet forbiddenEdges = program.getForbiddenEdges();
+  const EdgeSet& forbiddenEdges = snapshot.getForbiddenEdges();
 
   if(!solveRelaxation)
   {
-    lowerTimeBound = program.lowerBound();
-    upperTimeBound = program.upperBound();
+    lowerTimeBound = snapshot.getLowerBound();
+    upperTimeBound = snapshot.getUpperBound();
   }
 
-  if(costType == DualCostType::SIMPLE)
-  {
-    paths = findPaths(ReducedCosts(dualValues.getValues(), graph.travelTimes()),
-                      forbiddenEdges,
-                      lowerTimeBound,
-                      upperTimeBound,
-                      minReducedCost);
-  }
-  else
-  {
-    paths = findPaths(FarkasCosts(dualValues.getValues()),
-                      forbiddenEdges,
-                      lowerTimeBound,
-                      upperTimeBound,
-                      minReducedCost);
-  }
+  paths = findPaths(snapshot.getReducedCosts(),
+                    forbiddenEdges,
+                    lowerTimeBound,
+                    upperTimeBound,
+                    minReducedCost);
 
   if(paths.empty())
   {
@@ -65,7 +52,7 @@ SparsePathPricer::performPricing(DualCostType costType)
     if(minReducedCost)
     {
       assert(*minReducedCost <= 0.);
-      lowerBound = SCIPgetLPObjval(scip) + *minReducedCost;
+      lowerBound = snapshot.getObjectiveValue() + *minReducedCost;
     }
 
     return SparsePricingResult(paths, lowerBound);
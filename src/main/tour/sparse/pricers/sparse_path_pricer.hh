@@ -11,9 +11,9 @@ public:
   SparsePathPricer(SparseProgram& program,
                    idx numPaths = 20);
 
-  virtual SparsePricingResult performPricing(DualCostType costType) override;
+  virtual SparsePricingResult performPricing(const DualSnapshot& snapshot) override;
 
-  virtual std::vector<TimedPath> findPaths(const EdgeFunc<double>& reducedCosts,
+  virtual std::vector<TimedPath> findPaths(const EdgeMap<double>& reducedCosts,
                                            const EdgeSet& forbiddenEdges,
                                            const std::optional<double>& lowerTimeBound,
                                            const std::optional<double>& upperTimeBound,
@@ -17,7 +17,7 @@ public:
   {}
 
   std::vector<TimedPath>
-  findPaths(const EdgeFunc<double>& reducedCosts,
+  findPaths(const EdgeMap<double>& reducedCosts,
             const EdgeSet& forbiddenEdges,
             const std::optional<double>& lowerTimeBound,
             const std::optional<double>& upperTimeBound,
@@ -3,6 +3,7 @@
 
 #include "tour/sparse/sparse_program.hh"
 #include "sparse_pricing_result.hh"
+#include "dual_snapshot.hh"
 
 class SparsePricingManager;
 
@@ -59,7 +60,12 @@ protected:
 public:
   SparsePricer(SparseProgram& program);
 
-  virtual SparsePricingResult performPricing(DualCostType costType) = 0;
+  /**
+   * Performs pricing with respect to the given DualSnapshot.
+   * Implementations should not query the dual
+   * solution from SCIP themselves.
+   **/
+  virtual SparsePricingResult performPricing(const DualSnapshot& snapshot) = 0;
 };
 
 
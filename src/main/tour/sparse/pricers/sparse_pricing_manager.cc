@@ -27,7 +27,12 @@ SparsePricingManager::SparsePricingManager(SparseProgram& program,
   linkingConstraints(program.getLinkingConstraints()),
   flowConstraints(graph, nullptr),
   variables(graph, nullptr),
-  initiated(false)
+  initiated(false),
+  lastIncludedCuts(false),
+  linkingDuals(graph.underlyingGraph(), 0.),
+  flowDuals(graph, 0.),
+  dualValues(graph, 0.),
+  reducedCosts(graph, 0.)
 {
 }
 
@@ -308,6 +313,160 @@ SCIP_VAR* SparsePricingManager::addEdge(const TimedEdge& timedEdge)
 
 
 
+double SparsePricingManager::getDual(SCIP_CONS* cons,
+                                     DualCostType costType) const
+{
+  if(costType == DualCostType::FARKAS)
+  {
+    return SCIPgetDualfarkasLinear(scip, cons);
+  }
+
+  assert(costType == DualCostType::SIMPLE);
+
+  return SCIPgetDualsolLinear(scip, cons);
+}
+
+void SparsePricingManager::updateDualValues(DualCostType costType)
+{
+  const Graph& originalGraph = graph.underlyingGraph();
+
+  const bool includeCuts = program.hasSeparator() and program.getSeparator().hasCuts();
+
+  // Cuts contribute to arbitrary edges, their duals are not tracked
+  const bool incremental = (lastCostType == costType) and
+    !includeCuts and
+    !lastIncludedCuts;
+
+  // Recomputes the values of an edge from the stored duals,
+  // avoiding round-off errors accumulating over the rounds
+  auto update = [&](const TimedEdge& timedEdge)
+    {
+      const double dualValue = linkingDuals(graph.underlyingEdge(timedEdge)) +
+        flowDuals(timedEdge.getSource()) -
+        flowDuals(timedEdge.getTarget());
+
+      const double baseCost = (costType == DualCostType::SIMPLE) ? timedEdge.travelTime() : 0.;
+
+      dualValues(timedEdge) = dualValue;
+      reducedCosts(timedEdge) = baseCost - dualValue;
+    };
+
+  for(const Edge& originalEdge : originalGraph.getEdges())
+  {
+    const double linkingDual = getDual(linkingConstraints(originalEdge), costType);
+
+    if(incremental and linkingDual == linkingDuals(originalEdge))
+    {
+      continue;
+    }
+
+    linkingDuals(originalEdge) = linkingDual;
+
+    if(incremental)
+    {
+      for(const TimedEdge& timedEdge : graph.getTimedEdges(originalEdge))
+      {
+        update(timedEdge);
+      }
+    }
+  }
+
+  for(const TimedVertex& timedVertex : graph.getVertices())
+  {
+    SCIP_CONS* flowConstraint = flowConstraints(timedVertex);
+
+    const double flowDual = flowConstraint ? getDual(flowConstraint, costType) : 0.;
+
+    if(incremental and flowDual == flowDuals(timedVertex))
+    {
+      continue;
+    }
+
+    flowDuals(timedVertex) = flowDual;
+
+    if(incremental)
+    {
+      for(const TimedEdge& outgoing : graph.getOutgoing(timedVertex))
+      {
+        update(outgoing);
+      }
+
+      for(const TimedEdge& incoming : graph.getIncoming(timedVertex))
+      {
+        update(incoming);
+      }
+    }
+  }
+
+  if(!incremental)
+  {
+    for(const TimedEdge& timedEdge : graph.getEdges())
+    {
+      update(timedEdge);
+    }
+  }
+
+  if(includeCuts)
+  {
+    program.getSeparator().addDualCosts(dualValues, costType);
+
+    for(const TimedEdge& timedEdge : graph.getEdges())
+    {
+      const double baseCost = (costType == DualCostType::SIMPLE) ? timedEdge.travelTime() : 0.;
+
+      reducedCosts(timedEdge) = baseCost - dualValues(timedEdge);
+    }
+  }
+
+  lastCostType = costType;
+  lastIncludedCuts = includeCuts;
+}
+
+DualSnapshot SparsePricingManager::createSnapshot(DualCostType costType)
+{
+  const Graph& originalGraph = graph.underlyingGraph();
+
+  VertexMap<double> coveringDuals(originalGraph, 0.);
+
+  for(const Vertex& vertex : originalGraph.getVertices())
+  {
+    coveringDuals(vertex) = getDual(coveringConstraints(vertex), costType);
+  }
+
+  updateDualValues(costType);
+
+  EdgeMap<double> variableReducedCosts(graph, 0.);
+
+  if(costType == DualCostType::SIMPLE)
+  {
+    for(const TimedEdge& timedEdge : graph.getEdges())
+    {
+      SCIP_VAR* var = variables(timedEdge);
+
+      if(var == NULL)
+      {
+        continue;
+      }
+
+      const double reducedCost = SCIPgetVarRedcost(scip, var);
+
+      assert(reducedCost != SCIP_INVALID);
+
+      variableReducedCosts(timedEdge) = reducedCost;
+    }
+  }
+
+  return DualSnapshot(costType,
+                      EdgeMap<double>(dualValues),
+                      EdgeMap<double>(reducedCosts),
+                      std::move(variableReducedCosts),
+                      std::move(coveringDuals),
+                      program.getForbiddenEdges(),
+                      SCIPgetLPObjval(scip),
+                      program.lowerBound(),
+                      program.upperBound());
+}
+
 bool SparsePricingManager::contains(const TimedVertex& timedVertex) const
 {
   return !!flowConstraints(timedVertex);
@@ -331,7 +490,7 @@ SCIP_DECL_PRICERFARKAS(SparsePricingManager::scip_farkas)
 
   assert(sparsePricer);
 
-  auto pricingReuslt = sparsePricer->performPricing(DualCostType::FARKAS);
+  auto pricingReuslt = sparsePricer->performPricing(createSnapshot(DualCostType::FARKAS));
 
   addResult(pricingReuslt, DualCostType::FARKAS, NULL);
 
@@ -344,7 +503,7 @@ SCIP_DECL_PRICERREDCOST(SparsePricingManager::scip_redcost)
 {
   assert(sparsePricer);
 
-  auto pricingResult = sparsePricer->performPricing(DualCostType::SIMPLE);
+  auto pricingResult = sparsePricer->performPricing(createSnapshot(DualCostType::SIMPLE));
 
   addResult(pricingResult, DualCostType::SIMPLE, lowerbound);
 
@@ -6,6 +6,8 @@
 
 #include <objscip/objscip.h>
 
+#include <optional>
+
 #include "scip_utils.hh"
 
 #include "graph/graph.hh"
@@ -14,6 +16,7 @@
 #include "timed/timed_path.hh"
 
 #include "sparse_pricer.hh"
+#include "dual_snapshot.hh"
 
 class SparseProgram;
 class SparsePricingResult;
@@ -40,6 +43,20 @@ protected:
 
   bool initiated;
 
+  // The dual values and reduced costs of the timed edges as of the
+  // last snapshot, together with the duals they were derived from,
+  // so that they can be updated when only some of the duals change
+  std::optional<DualCostType> lastCostType;
+  bool lastIncludedCuts;
+  EdgeMap<double> linkingDuals;
+  VertexMap<double> flowDuals;
+  EdgeMap<double> dualValues;
+  EdgeMap<double> reducedCosts;
+
+  double getDual(SCIP_CONS* cons, DualCostType costType) const;
+
+  void updateDualValues(DualCostType costType);
+
   void addVertex(const TimedVertex& timedVertex);
 
   bool addSolution(const TimedPath& path,
@@ -61,6 +78,14 @@ public:
 
   bool addTour(const Tour& tour, SCIP_HEUR* heur = nullptr);
 
+  /**
+   * Takes a snapshot of the dual solution of the current LP. The
+   * dual values and reduced costs of the timed edges are updated
+   * incrementally with respect to the previous snapshot if
+   * no separated inequalities contribute to them.
+   **/
+  DualSnapshot createSnapshot(DualCostType costType);
+
   void addPath(const TimedPath& path);
 
   std::string getName() const;
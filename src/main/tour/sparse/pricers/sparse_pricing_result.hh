@@ -28,6 +28,14 @@ public:
       lowerBound(lowerBound)
   {}
 
+  SparsePricingResult(std::vector<TimedEdge> edges,
+                      std::vector<TimedPath> paths,
+                      std::optional<double> lowerBound = {})
+    : edges(edges),
+      paths(paths),
+      lowerBound(lowerBound)
+  {}
+
   const std::vector<TimedEdge>& getEdges() const
   {
     return edges;
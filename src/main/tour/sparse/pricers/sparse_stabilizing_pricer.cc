@@ -38,7 +38,9 @@ SparseStabilizingPricer::findPaths(const EdgeFunc<double>& dualValues,
 
   std::optional<double> minCost;
 
-  auto paths = sparsePricer->findPaths(ReducedCosts(dualValues, graph.travelTimes()),
+  const EdgeMap<double> reducedCosts(graph, ReducedCosts(dualValues, graph.travelTimes()));
+
+  auto paths = sparsePricer->findPaths(reducedCosts,
                                        forbiddenEdges,
                                        lowerTimeBound,
                                        upperTimeBound,
@@ -146,60 +148,49 @@ void SparseStabilizingPricer::checkDualFeasibility()
 }
 
 SparseStabilizingPricer::DualValues
-SparseStabilizingPricer::getCurrentDualValues()
+SparseStabilizingPricer::getCurrentDualValues(const DualSnapshot& snapshot)
 {
-  EdgeMap<double> currentDualValues = program.getDualValues(DualCostType::SIMPLE);
+  assert(snapshot.getCostType() == DualCostType::SIMPLE);
+
+  EdgeMap<double> currentDualValues = snapshot.getDualValues();
 
   // add reduced costs of variables
   {
-    const auto& variables = getVariables();
+    const EdgeMap<double>& variableReducedCosts = snapshot.getVariableReducedCosts();
 
     for(const TimedEdge& timedEdge : graph.getEdges())
     {
-      SCIP_VAR* var = variables(timedEdge);
-
-      if(var == NULL)
-      {
-        continue;
-      }
-
-      double reducedCost = SCIPgetVarRedcost(scip, var);
-
-      assert(reducedCost != SCIP_INVALID);
-
-      reducedCost = std::min(reducedCost, 0.);
-
-      currentDualValues(timedEdge) += reducedCost;
+      currentDualValues(timedEdge) += std::min(variableReducedCosts(timedEdge), 0.);
     }
   }
 
-  const double upperBound = SCIPgetLPObjval(scip);
+  const double upperBound = snapshot.getObjectiveValue();
 
   return DualValues(currentDualValues, 0., upperBound);
 }
 
 SparsePricingResult
-SparseStabilizingPricer::performPricing(DualCostType costType)
+SparseStabilizingPricer::performPricing(const DualSnapshot& snapshot)
 {
-  if(costType == DualCostType::FARKAS)
+  if(snapshot.getCostType() == DualCostType::FARKAS)
   {
-    return sparsePricer->performPricing(costType);
+    return sparsePricer->performPricing(snapshot);
   }
 
   if(program.hasFixedEdges())
   {
-    return sparsePricer->performPricing(costType);
+    return sparsePricer->performPricing(snapshot);
   }
 
   if(program.hasSeparator() && program.getSeparator().hasCuts())
   {
-    return sparsePricer->performPricing(costType);
+    return sparsePricer->performPricing(snapshot);
   }
 
-  const DualValues currentDualValues = getCurrentDualValues();
+  const DualValues currentDualValues = getCurrentDualValues(snapshot);
 
   bool misPriced = false;
-  const double upperBound = SCIPgetLPObjval(scip);
+  const double upperBound = snapshot.getObjectiveValue();
 
   Log(info) << "Performing stabilized reduced cost pricing";
 
@@ -225,7 +216,7 @@ SparseStabilizingPricer::performPricing(DualCostType costType)
     {
       Log(info) << "Current solution is below relaxation, falling back to standard pricing";
 
-      return sparsePricer->performPricing(costType);
+      return sparsePricer->performPricing(snapshot);
     }
 
     assert(cmp::ge(upperBound, centeredBound()));
@@ -63,7 +63,7 @@ private:
   std::vector<TimedPath> findPaths(const EdgeFunc<double>& reducedCosts,
                                    double& minReducedCost);
 
-  DualValues getCurrentDualValues();
+  DualValues getCurrentDualValues(const DualSnapshot& snapshot);
 
   void checkUpperBound();
 
@@ -73,7 +73,7 @@ public:
   SparseStabilizingPricer(SparseProgram& program,
                           std::unique_ptr<SparsePathPricer>&& sparsePricer);
 
-  virtual SparsePricingResult performPricing(DualCostType costType) override;
+  virtual SparsePricingResult performPricing(const DualSnapshot& snapshot) override;
 };
 
 
@@ -25,7 +25,11 @@ SparseProgram::SparseProgram(const Tour& initialTour,
     distances(distances),
     initialTour(initialTour),
     source(initialTour.getSource()),
-    graph(createTimeExpandedGraph(initialTour, distances, lowerBound)),
+    graph(createCachedTimeExpandedGraph(initialTour,
+                                        distances,
+                                        settings.graphCacheFile,
+                                        lowerBound,
+                                        settings.numThreads)),
     originalGraph(graph.underlyingGraph()),
     combinedVariables(originalGraph, nullptr),
     linkingConstraints(originalGraph, nullptr),
@@ -412,88 +416,6 @@ EdgeSet SparseProgram::getForbiddenEdges() const
   return forbiddenEdges;
 }
 
-EdgeMap<double> SparseProgram::getDualValues(DualCostType costType) const
-{
-  EdgeMap<double> dualValues(graph, 0);
-
-  // linking constraints
-  {
-    const EdgeMap<SCIP_CONS*>& linkingConstraints = getPricingManager().getLinkingConstraints();
-
-    for(const Edge& originalEdge : originalGraph.getEdges())
-    {
-      double linkingCost = 0;
-
-      if(costType == DualCostType::FARKAS)
-      {
-        linkingCost = SCIPgetDualfarkasLinear(scip, linkingConstraints(originalEdge));
-      }
-      else
-      {
-        assert(costType == DualCostType::SIMPLE);
-
-        linkingCost = SCIPgetDualsolLinear(scip, linkingConstraints(originalEdge));
-      }
-
-      for(const TimedEdge& timedEdge : graph.getTimedEdges(originalEdge))
-      {
-        dualValues(timedEdge) += linkingCost;
-      }
-    }
-  }
-
-  // flow constraints (stored in pricer)
-  {
-    const VertexMap<SCIP_CONS*>& flowConstraints = getPricingManager().getFlowConstraints();
-
-    for(const TimedVertex& timedVertex : graph.getVertices())
-    {
-      SCIP_CONS* flowConstraint = flowConstraints(timedVertex);
-
-      if(!flowConstraint)
-      {
-        continue;
-      }
-
-      double flowCost = 0;
-
-      if(costType == DualCostType::FARKAS)
-      {
-        flowCost = SCIPgetDualfarkasLinear(scip, flowConstraint);
-      }
-      else
-      {
-        assert(costType == DualCostType::SIMPLE);
-
-        flowCost = SCIPgetDualsolLinear(scip, flowConstraint);
-      }
-
-      if(flowCost == 0.)
-      {
-        continue;
-      }
-
-      for(const TimedEdge& outgoing : graph.getOutgoing(timedVertex))
-      {
-        dualValues(outgoing) += flowCost;
-      }
-
-      for(const TimedEdge& incoming : graph.getIncoming(timedVertex))
-      {
-        dualValues(incoming) += -flowCost;
-      }
-    }
-  }
-
-  // separated inequalities
-  if(separator)
-  {
-    separator->addDualCosts(dualValues, costType);
-  }
-
-  return dualValues;
-}
-
 SparseSolutionValues SparseProgram::solutionValues() const
 {
   return SparseSolutionValues(getSCIP(),
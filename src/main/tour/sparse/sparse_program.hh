@@ -130,8 +130,6 @@ public:
     return EdgeSolutionValues(scip, combinedVariables.getValues());
   }
 
-  EdgeMap<double> getDualValues(DualCostType costType) const;
-
   SparsePricingManager& getPricingManager() const
   {
     assert(pricer);
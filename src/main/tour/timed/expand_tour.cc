@@ -1,107 +1,252 @@
 #include "expand_tour.hh"
 
-#include <queue>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
 
 #include "log.hh"
 
-struct VertexComparator
+namespace
 {
-  bool operator()(const TimedVertex& first,
-                  const TimedVertex& second) const
+  struct ExpandedEdge
   {
-    return first.getTime() > second.getTime();
+    Edge edge;
+    idx arrivalTime;
+  };
+
+  // FNV-1a, which is stable across builds and platforms
+  const uint64_t hashOffset = 14695981039346656037ull;
+  const uint64_t hashPrime = 1099511628211ull;
+
+  void combineHash(uint64_t& hash, uint64_t value)
+  {
+    for(idx i = 0; i < sizeof(value); ++i)
+    {
+      hash ^= (value >> (8*i)) & 0xff;
+      hash *= hashPrime;
+    }
+  }
+
+  /**
+   * Computes a key identifying the inputs of an expansion, i.e.,
+   * the tour, the lower bound, and the distances from each tour
+   * vertex to all vertices at the time the tour reaches it.
+   **/
+  uint64_t expansionKey(const Tour& tour,
+                        TimedDistanceFunc& distances,
+                        idx lowerBound)
+  {
+    const Graph& graph = tour.getGraph();
+    const std::vector<Vertex> vertices = graph.getVertices().collect();
+    const std::vector<Vertex>& tourVertices = tour.getVertices();
+
+    uint64_t hash = hashOffset;
+
+    combineHash(hash, vertices.size());
+    combineHash(hash, graph.getEdges().size());
+    combineHash(hash, lowerBound);
+
+    std::vector<num> values(vertices.size());
+
+    idx currentTime = 0;
+
+    for(idx i = 0; i < tourVertices.size(); ++i)
+    {
+      const Vertex& currentVertex = tourVertices[i];
+      const Vertex& nextVertex = tourVertices[(i + 1) % tourVertices.size()];
+
+      combineHash(hash, currentVertex.getIndex());
+
+      distances.distances(currentVertex, currentTime, vertices, values);
+
+      for(const num& value : values)
+      {
+        combineHash(hash, value);
+      }
+
+      currentTime += distances(currentVertex, nextVertex, currentTime);
+    }
+
+    return hash;
   }
-};
+}
 
 TimeExpandedGraph createTimeExpandedGraph(const Tour& tour,
                                           TimedDistanceFunc& distances,
-                                          idx lowerBound)
+                                          idx lowerBound,
+                                          idx numThreads)
 {
   // TODO: Add predecessors
 
   const Graph& originalGraph = tour.getGraph();
 
-  TimeExpandedGraph graph(originalGraph);
   const idx timeHorizon = tour.cost(distances);
+  TimeExpandedGraph graph(originalGraph, timeHorizon);
 
   Log(info) << "Expanding a tour within a time horizon of " << timeHorizon
             << " on " << originalGraph.getVertices().size()
             << " vertices";
 
-  std::priority_queue<TimedVertex,
-                      std::vector<TimedVertex>,
-                      VertexComparator> unprocessed;
-
   const Vertex initialVertex = tour.getSource();
 
-  unprocessed.push(graph.addVertex(initialVertex, 0));
+  // The timed vertices of each time which remain to be expanded.
+  // Travel times are positive, so expanding the vertices of
+  // one time only adds vertices to later times
+  std::vector<std::vector<TimedVertex>> levels(timeHorizon + 1);
+
+  levels[0].push_back(graph.addVertex(initialVertex, 0));
+
+  std::vector<std::vector<ExpandedEdge>> buffers;
 
-  while(!unprocessed.empty())
+  // Start the threads once rather than for every level
+  ThreadPool pool(numThreads);
+
+  for(idx time = 0; time <= timeHorizon; ++time)
   {
-    const TimedVertex currentVertex = unprocessed.top();
-    const Vertex sourceVertex = graph.underlyingVertex(currentVertex);
+    const std::vector<TimedVertex>& level = levels[time];
 
-    unprocessed.pop();
+    buffers.resize(std::max(buffers.size(), level.size()));
 
-    assert(graph.getOutgoing(currentVertex).empty());
+    parallelFor(pool,
+                level.size(),
+                [&](idx i)
+                {
+                  const TimedVertex& currentVertex = level[i];
+                  const Vertex sourceVertex = graph.underlyingVertex(currentVertex);
+                  std::vector<ExpandedEdge>& buffer = buffers[i];
 
-    if(sourceVertex == initialVertex && currentVertex.getTime() > 0)
-    {
-      continue;
-    }
+                  buffer.clear();
 
-    const idx departureTime = currentVertex.getTime();
+                  if(sourceVertex == initialVertex && time > 0)
+                  {
+                    return;
+                  }
 
-    for(const Edge& outgoing : originalGraph.getOutgoing(sourceVertex))
-    {
-      const Vertex& targetVertex = outgoing.getTarget();
+                  std::vector<Edge> edges;
+                  std::vector<Vertex> targets;
 
-      if(targetVertex == graph.underlyingVertex(currentVertex))
-      {
-        continue;
-      }
+                  for(const Edge& outgoing : originalGraph.getOutgoing(sourceVertex))
+                  {
+                    if(outgoing.getTarget() != sourceVertex)
+                    {
+                      edges.push_back(outgoing);
+                      targets.push_back(outgoing.getTarget());
+                    }
+                  }
 
-      const idx arrivalTime = departureTime + distances(sourceVertex,
-                                                        targetVertex,
-                                                        departureTime);
+                  // query all neighbors at once
+                  std::vector<num> travelTimes(targets.size());
 
-      assert(arrivalTime > departureTime);
+                  distances.distances(sourceVertex, time, targets, travelTimes);
 
-      if(targetVertex == initialVertex && arrivalTime < lowerBound)
-      {
-        continue;
-      }
+                  for(idx j = 0; j < edges.size(); ++j)
+                  {
+                    const Edge& outgoing = edges[j];
+                    const Vertex& targetVertex = targets[j];
 
-      if(arrivalTime > timeHorizon)
-      {
-        continue;
-      }
+                    const idx arrivalTime = time + travelTimes[j];
 
-      const idx sourceTime = arrivalTime + distances(targetVertex,
-                                                     initialVertex,
-                                                     arrivalTime);
+                    assert(arrivalTime > time);
 
-      if(sourceTime > timeHorizon)
-      {
-        continue;
-      }
+                    if(targetVertex == initialVertex && arrivalTime < lowerBound)
+                    {
+                      continue;
+                    }
 
-      if(graph.hasVertex(targetVertex, arrivalTime))
-      {
-        graph.addEdge(currentVertex, graph.getVertex(targetVertex, arrivalTime), outgoing);
-      }
-      else
+                    if(arrivalTime > timeHorizon)
+                    {
+                      continue;
+                    }
+
+                    const idx sourceTime = arrivalTime + distances(targetVertex,
+                                                                   initialVertex,
+                                                                   arrivalTime);
+
+                    if(sourceTime > timeHorizon)
+                    {
+                      continue;
+                    }
+
+                    buffer.push_back(ExpandedEdge{outgoing, arrivalTime});
+                  }
+                });
+
+    // Merge the buffers in the order of the level,
+    // so that the graph does not depend on the scheduling
+    for(idx i = 0; i < level.size(); ++i)
+    {
+      const TimedVertex& currentVertex = level[i];
+
+      assert(graph.getOutgoing(currentVertex).empty());
+
+      for(const ExpandedEdge& expandedEdge : buffers[i])
       {
-        const TimedVertex nextVertex = graph.addVertex(targetVertex, arrivalTime);
-        graph.addEdge(currentVertex, nextVertex, outgoing);
-        unprocessed.push(nextVertex);
+        const Vertex& targetVertex = expandedEdge.edge.getTarget();
+        const idx arrivalTime = expandedEdge.arrivalTime;
+
+        if(graph.hasVertex(targetVertex, arrivalTime))
+        {
+          graph.addEdge(currentVertex,
+                        graph.getVertex(targetVertex, arrivalTime),
+                        expandedEdge.edge);
+        }
+        else
+        {
+          const TimedVertex nextVertex = graph.addVertex(targetVertex, arrivalTime);
+          graph.addEdge(currentVertex, nextVertex, expandedEdge.edge);
+          levels[arrivalTime].push_back(nextVertex);
+        }
       }
     }
+
+    levels[time] = std::vector<TimedVertex>();
   }
 
+  graph.compact();
+
   Log(info) << "Expanded graph has " << graph.getVertices().size()
             << " vertices and " << graph.getEdges().size()
             << " edges";
 
   return graph;
 }
+
+TimeExpandedGraph createCachedTimeExpandedGraph(const Tour& tour,
+                                                TimedDistanceFunc& distances,
+                                                const std::string& cacheFile,
+                                                idx lowerBound,
+                                                idx numThreads)
+{
+  if(cacheFile.empty())
+  {
+    return createTimeExpandedGraph(tour, distances, lowerBound, numThreads);
+  }
+
+  const uint64_t key = expansionKey(tour, distances, lowerBound);
+
+  if(std::ifstream(cacheFile).good())
+  {
+    Log(info) << "Reading time-expanded graph from " << cacheFile;
+
+    try
+    {
+      return TimeExpandedGraph::read(tour.getGraph(), cacheFile, key);
+    }
+    catch(const std::invalid_argument& error)
+    {
+      Log(warning) << error.what() << ", expanding the tour again";
+    }
+  }
+
+  TimeExpandedGraph graph = createTimeExpandedGraph(tour,
+                                                    distances,
+                                                    lowerBound,
+                                                    numThreads);
+
+  Log(info) << "Writing time-expanded graph to " << cacheFile;
+
+  graph.write(cacheFile, key);
+
+  return graph;
+}
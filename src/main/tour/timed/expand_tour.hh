@@ -1,13 +1,42 @@
 #ifndef EXPAND_TOUR_HH
 #define EXPAND_TOUR_HH
 
+#include <string>
+
 #include "tour/tour.hh"
 
+#include "parallel.hh"
+
 #include "timed/time_expanded_graph.hh"
 #include "timed/timed_vertex_func.hh"
 
+/**
+ * Expands the given Tour into a TimeExpandedGraph containing all
+ * timed vertices reachable within the cost of the tour.
+ *
+ * The timed vertices are expanded level by level in the order of
+ * their times, where the vertices of each level are expanded
+ * concurrently using the given number of threads. The resulting
+ * graph does not depend on the number of threads. The distances
+ * must support concurrent queries if more than one thread is used.
+ **/
 TimeExpandedGraph createTimeExpandedGraph(const Tour& tour,
                                           TimedDistanceFunc& distances,
-                                          idx lowerBound = 0);
+                                          idx lowerBound = 0,
+                                          idx numThreads = defaultNumThreads());
+
+/**
+ * As createTimeExpandedGraph(), using the given file as a cache:
+ * If the file exists and was written for the same tour, lower
+ * bound and distances, the graph is read from it. Otherwise the
+ * tour is expanded and the graph is written to the file. The
+ * inputs are identified by a key sampling the distances from the
+ * tour vertices. An empty file name disables the cache.
+ **/
+TimeExpandedGraph createCachedTimeExpandedGraph(const Tour& tour,
+                                                TimedDistanceFunc& distances,
+                                                const std::string& cacheFile,
+                                                idx lowerBound = 0,
+                                                idx numThreads = defaultNumThreads());
 
 #endif /* EXPAND_TOUR_HH */
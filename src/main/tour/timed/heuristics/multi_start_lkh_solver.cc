@@ -0,0 +1,152 @@
+#include "multi_start_lkh_solver.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "log.hh"
+#include "timer.hh"
+
+namespace
+{
+  // The number of calls between two queries of the clock
+  const idx stopInterval = 1000;
+}
+
+MultiStartLKHSolver::MultiStartLKHSolver(const Graph& graph,
+                                         const std::vector<Vertex>& vertices,
+                                         TimedDistanceFunc& distances,
+                                         TimedLKHSolver::ScoreFunction scoreFunction,
+                                         idx numThreads,
+                                         std::shared_ptr<const TimedCandidateLists> candidateLists)
+  : graph(graph),
+    distances(distances),
+    solver(graph, vertices, distances, scoreFunction, candidateLists),
+    numThreads(std::max(numThreads, (idx) 1))
+{}
+
+std::vector<Vertex> MultiStartLKHSolver::perturb(const std::vector<Vertex>& tourVertices,
+                                                 std::mt19937& engine) const
+{
+  const idx size = tourVertices.size();
+
+  // The source remains at the first position
+  if(size < 5)
+  {
+    return tourVertices;
+  }
+
+  std::vector<idx> cuts;
+
+  std::uniform_int_distribution<idx> distribution(1, size - 1);
+
+  while(cuts.size() < 3)
+  {
+    const idx cut = distribution(engine);
+
+    if(std::find(std::begin(cuts), std::end(cuts), cut) == std::end(cuts))
+    {
+      cuts.push_back(cut);
+    }
+  }
+
+  std::sort(std::begin(cuts), std::end(cuts));
+
+  const auto begin = std::begin(tourVertices);
+
+  // [0, a) + [b, c) + [a, b) + [c, size)
+  std::vector<Vertex> nextVertices;
+  nextVertices.reserve(size);
+
+  nextVertices.insert(std::end(nextVertices), begin, begin + cuts[0]);
+  nextVertices.insert(std::end(nextVertices), begin + cuts[1], begin + cuts[2]);
+  nextVertices.insert(std::end(nextVertices), begin + cuts[0], begin + cuts[1]);
+  nextVertices.insert(std::end(nextVertices), begin + cuts[2], std::end(tourVertices));
+
+  assert(nextVertices.size() == size);
+
+  return nextVertices;
+}
+
+Tour MultiStartLKHSolver::findTour(const Tour& initialTour,
+                                   double timeLimit,
+                                   idx maxRuns,
+                                   idx seed)
+{
+  Timer timer;
+
+  TimedDistanceEvaluator evaluator(distances);
+
+  const num initialCost = evaluator(initialTour);
+
+  std::atomic<num> bestCost(initialCost);
+  std::atomic<idx> numRuns(0);
+  std::atomic<idx> completedRuns(0);
+
+  // The best tour found so far, perturbed by all workers
+  std::mutex bestMutex;
+  std::vector<Vertex> bestVertices = initialTour.getVertices();
+  num bestVerticesCost = initialCost;
+
+  std::atomic<bool> timedOut(false);
+
+  parallelFor(numThreads,
+              [&](idx worker)
+              {
+                std::mt19937 engine(seed + worker);
+
+                idx numCalls = 0;
+
+                // The searches call this at every node, querying
+                // the clock only every few calls
+                auto stopped = [&]() -> bool
+                  {
+                    if(!timedOut and
+                       (numCalls++ % stopInterval) == 0 and
+                       timer.elapsed() >= timeLimit)
+                    {
+                      timedOut = true;
+                    }
+
+                    return timedOut;
+                  };
+
+                for(idx run = numRuns++;
+                    run < maxRuns and !stopped();
+                    run = numRuns++)
+                {
+                  std::vector<Vertex> currentVertices;
+
+                  {
+                    std::lock_guard<std::mutex> guard(bestMutex);
+                    currentVertices = bestVertices;
+                  }
+
+                  const Tour startTour(graph,
+                                       (run == 0) ? currentVertices : perturb(currentVertices, engine));
+
+                  const Tour nextTour = solver.improveTour(startTour, bestCost, stopped);
+
+                  const num nextCost = evaluator(nextTour);
+
+                  {
+                    std::lock_guard<std::mutex> guard(bestMutex);
+
+                    if(nextCost < bestVerticesCost)
+                    {
+                      bestVertices = nextTour.getVertices();
+                      bestVerticesCost = nextCost;
+                    }
+                  }
+
+                  ++completedRuns;
+                }
+              },
+              numThreads);
+
+  Log(info) << "Found a tour with cost " << bestVerticesCost
+            << " after " << completedRuns.load() << " runs"
+            << " in " << timer.elapsed() << " seconds";
+
+  return Tour(graph, bestVertices);
+}
@@ -0,0 +1,57 @@
+#ifndef MULTI_START_LKH_SOLVER_HH
+#define MULTI_START_LKH_SOLVER_HH
+
+#include <limits>
+#include <random>
+
+#include "graph/graph.hh"
+
+#include "timed/timed_vertex_func.hh"
+
+#include "tour/tour.hh"
+
+#include "timed_lkh_solver.hh"
+
+#include "parallel.hh"
+
+/**
+ * Runs randomized TimedLKHSolver searches concurrently until a
+ * wall-clock budget or a number of runs is exhausted. Each worker
+ * repeatedly perturbs the best tour found by any of the workers by
+ * a random double-bridge move and improves the result. The cost of
+ * the shared best tour is used to prune the searches.
+ * The distances (and the score function) must support
+ * concurrent queries if more than one thread is used.
+ **/
+class MultiStartLKHSolver
+{
+private:
+  const Graph& graph;
+  TimedDistanceFunc& distances;
+  TimedLKHSolver solver;
+  idx numThreads;
+
+  std::vector<Vertex> perturb(const std::vector<Vertex>& tourVertices,
+                              std::mt19937& engine) const;
+
+public:
+  MultiStartLKHSolver(const Graph& graph,
+                      const std::vector<Vertex>& vertices,
+                      TimedDistanceFunc& distances,
+                      TimedLKHSolver::ScoreFunction scoreFunction,
+                      idx numThreads = 1,
+                      std::shared_ptr<const TimedCandidateLists> candidateLists = nullptr);
+
+  /**
+   * Finds a tour starting from the given one. The first run improves
+   * the initial tour itself. Runs are aborted once the time limit
+   * (in seconds) is exceeded. Using a single thread and an infinite time limit,
+   * the result only depends on the seed.
+   **/
+  Tour findTour(const Tour& initialTour,
+                double timeLimit,
+                idx maxRuns = std::numeric_limits<idx>::max(),
+                idx seed = 0);
+};
+
+#endif /* MULTI_START_LKH_SOLVER_HH */
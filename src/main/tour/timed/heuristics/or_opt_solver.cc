@@ -0,0 +1,174 @@
+#include "or_opt_solver.hh"
+
+#include <algorithm>
+
+#include "log.hh"
+
+OrOptSolver::OrOptSolver(const Graph& graph,
+                         TimedDistanceFunc& distances,
+                         idx maxLength,
+                         bool fifo)
+  : graph(graph),
+    distances(distances),
+    evaluator(distances),
+    maxLength(maxLength),
+    fifo(fifo)
+{
+  if(maxLength == 0)
+  {
+    throw std::invalid_argument("Segments must not be empty");
+  }
+}
+
+template <class It>
+num OrOptSolver::evaluate(const ArrivalTimes<>& arrivalTimes,
+                          idx begin,
+                          idx end,
+                          It first,
+                          It last) const
+{
+  if(fifo)
+  {
+    return arrivalTimes.evaluateFIFO(begin, end, first, last);
+  }
+
+  return arrivalTimes.evaluate(begin, end, first, last);
+}
+
+bool OrOptSolver::improve(std::vector<Vertex>& vertices,
+                          ArrivalTimes<>& arrivalTimes) const
+{
+  const idx size = vertices.size();
+
+  bool improved = false;
+
+  // The vertices replacing the range of positions changed by a move
+  std::vector<Vertex> middleVertices;
+  middleVertices.reserve(size);
+
+  auto apply = [&](idx begin)
+    {
+      std::copy(std::begin(middleVertices),
+                std::end(middleVertices),
+                std::begin(vertices) + begin);
+
+      arrivalTimes.reset(vertices);
+
+      improved = true;
+    };
+
+  // The source remains at the first position
+  for(idx first = 1; first < size; ++first)
+  {
+    for(idx length = 1; length <= maxLength and first + length <= size; ++length)
+    {
+      const auto segmentBegin = std::begin(vertices) + first;
+      const auto segmentEnd = segmentBegin + length;
+
+      for(idx reversed = 0; reversed <= ((length > 1) ? 1 : 0); ++reversed)
+      {
+        bool moved = false;
+
+        auto insertSegment = [&]()
+          {
+            if(reversed)
+            {
+              middleVertices.insert(std::end(middleVertices),
+                                    std::make_reverse_iterator(segmentEnd),
+                                    std::make_reverse_iterator(segmentBegin));
+            }
+            else
+            {
+              middleVertices.insert(std::end(middleVertices),
+                                    segmentBegin,
+                                    segmentEnd);
+            }
+          };
+
+        // Move the segment in front of the vertex at position
+        // "target", or to the end of the tour if target == size
+        for(idx target = 1; target <= size and not moved; ++target)
+        {
+          if(target >= first and target <= first + length)
+          {
+            if(not reversed or target != first)
+            {
+              continue;
+            }
+          }
+
+          middleVertices.clear();
+
+          idx begin, end;
+
+          if(target <= first)
+          {
+            // [target, first + length) => segment + [target, first)
+            begin = target;
+            end = first + length;
+
+            insertSegment();
+
+            middleVertices.insert(std::end(middleVertices),
+                                  std::begin(vertices) + target,
+                                  segmentBegin);
+          }
+          else
+          {
+            // [first, target) => [first + length, target) + segment
+            begin = first;
+            end = target;
+
+            middleVertices.insert(std::end(middleVertices),
+                                  segmentEnd,
+                                  std::begin(vertices) + target);
+
+            insertSegment();
+          }
+
+          const num nextCost = evaluate(arrivalTimes,
+                                        begin,
+                                        end,
+                                        std::begin(middleVertices),
+                                        std::end(middleVertices));
+
+          if(nextCost < arrivalTimes.cost())
+          {
+            apply(begin);
+            moved = true;
+          }
+        }
+
+        if(moved)
+        {
+          break;
+        }
+      }
+    }
+  }
+
+  return improved;
+}
+
+Tour OrOptSolver::findTour(const Tour& initialTour)
+{
+  assert(initialTour.connects(graph.getVertices().collect()));
+
+  std::vector<Vertex> vertices = initialTour.getVertices();
+
+  ArrivalTimes<> arrivalTimes(evaluator, vertices);
+
+  Log(info) << "Cost of initial tour: " << arrivalTimes.cost();
+
+  while(improve(vertices, arrivalTimes))
+  {
+    Log(info) << "Tour costs dropped to " << arrivalTimes.cost();
+  }
+
+  Tour bestTour(graph, vertices);
+
+  assert(bestTour.connects(graph.getVertices().collect()));
+  assert(bestTour.getSource() == initialTour.getSource());
+
+  return bestTour;
+}
@@ -0,0 +1,52 @@
+#ifndef OR_OPT_SOLVER_HH
+#define OR_OPT_SOLVER_HH
+
+#include "graph/graph.hh"
+
+#include "timed/timed_vertex_func.hh"
+
+#include "tour/tour.hh"
+#include "tour/heuristics/arrival_times.hh"
+
+/**
+ * A local search relocating segments of up to a given number of
+ * consecutive vertices (Or-opt moves), possibly reversing them.
+ * Moves are evaluated against the arrival times of the current tour,
+ * such that only the changed part of the tour and its suffix are
+ * re-evaluated. If the distances satisfy the FIFO property, the
+ * evaluation of a move stops as soon as it can no longer improve
+ * the tour.
+ **/
+class OrOptSolver
+{
+private:
+  const Graph& graph;
+  TimedDistanceFunc& distances;
+  TimedDistanceEvaluator evaluator;
+  idx maxLength;
+  bool fifo;
+
+  template <class It>
+  num evaluate(const ArrivalTimes<>& arrivalTimes,
+               idx begin,
+               idx end,
+               It first,
+               It last) const;
+
+  /**
+   * Performs a pass over all moves, applying each improving
+   * move as soon as it is found.
+   **/
+  bool improve(std::vector<Vertex>& vertices,
+               ArrivalTimes<>& arrivalTimes) const;
+
+public:
+  OrOptSolver(const Graph& graph,
+              TimedDistanceFunc& distances,
+              idx maxLength = 3,
+              bool fifo = false);
+
+  Tour findTour(const Tour& initialTour);
+};
+
+#endif /* OR_OPT_SOLVER_HH */
@@ -1,19 +1,118 @@
 #include "restricted_dynamic_solver.hh"
 
 #include "log.hh"
+#include "parallel.hh"
 
 #include <algorithm>
-#include <bitset>
-#include <set>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace
 {
-  const idx setSize = 64;
-  typedef std::bitset<setSize> BitSet;
+  const idx wordSize = 64;
+
+  /**
+   * A set of vertex indices stored in a fixed number of words. All
+   * operations work word-wise on fixed-size arrays, which the
+   * compiler can unroll and vectorize.
+   **/
+  template <idx numWords>
+  class BitSet
+  {
+  private:
+    typedef uint64_t Word;
+
+    std::array<Word, numWords> words;
+
+  public:
+    BitSet()
+      : words{}
+    {}
+
+    bool operator[](idx index) const
+    {
+      assert(index < numWords * wordSize);
+      return (words[index / wordSize] >> (index % wordSize)) & 1;
+    }
+
+    void set(idx index)
+    {
+      assert(index < numWords * wordSize);
+      words[index / wordSize] |= ((Word) 1) << (index % wordSize);
+    }
+
+    idx count() const
+    {
+      idx value = 0;
+
+      for(const Word& word : words)
+      {
+        value += __builtin_popcountll(word);
+      }
+
+      return value;
+    }
+
+    bool operator==(const BitSet& other) const
+    {
+      Word difference = 0;
+
+      for(idx i = 0; i < numWords; ++i)
+      {
+        difference |= words[i] ^ other.words[i];
+      }
 
+      return difference == 0;
+    }
+
+    bool operator!=(const BitSet& other) const
+    {
+      return !(*this == other);
+    }
+
+    /**
+     * Compares the sets with respect to the first index
+     * contained in exactly one of them, the set not
+     * containing the index is considered to be smaller.
+     **/
+    bool operator<(const BitSet& other) const
+    {
+      for(idx i = 0; i < numWords; ++i)
+      {
+        const Word difference = words[i] ^ other.words[i];
+
+        if(difference)
+        {
+          return (other.words[i] >> __builtin_ctzll(difference)) & 1;
+        }
+      }
+
+      return false;
+    }
+
+    std::size_t hash() const
+    {
+      std::size_t value = 0;
+
+      for(const Word& word : words)
+      {
+        value = (value ^ word) * 0x9e3779b97f4a7c15ull;
+        value ^= value >> 32;
+      }
+
+      return value;
+    }
+  };
+
+  template <idx numWords>
   struct Entry
   {
-    BitSet entries;
+    BitSet<numWords> entries;
     idx lastEntry;
     num arrivalTime;
     const Entry* predecessor;
@@ -27,7 +126,7 @@ namespace
         predecessor(&other)
     {
       assert(!other.entries[lastEntry]);
-      entries[lastEntry] = 1;
+      entries.set(lastEntry);
     }
 
     Entry(idx entry)
@@ -35,7 +134,7 @@ namespace
         arrivalTime(0),
         predecessor(nullptr)
     {
-      entries[lastEntry] = 1;
+      entries.set(lastEntry);
     }
 
     std::vector<Vertex> getVertices(const std::vector<Vertex>& vertices) const
@@ -55,59 +154,251 @@ namespace
     }
   };
 
-  struct CostCompare
+  /**
+   * The state of an entry in the dynamic program, entries with
+   * the same state only differ in their arrival times.
+   **/
+  template <idx numWords>
+  struct EntryState
   {
-    bool operator()(const Entry& first, const Entry& second) const
+    BitSet<numWords> entries;
+    idx lastEntry;
+
+    EntryState(const Entry<numWords>& entry)
+      : entries(entry.entries),
+        lastEntry(entry.lastEntry)
+    {}
+
+    bool operator==(const EntryState& other) const
     {
-      return first.arrivalTime < second.arrivalTime;
+      return lastEntry == other.lastEntry and entries == other.entries;
     }
   };
 
-  struct BitSetCompare
+  template <idx numWords>
+  struct EntryStateHasher
   {
-    bool operator()(const BitSet& first, const BitSet& second) const
+    std::size_t operator()(const EntryState<numWords>& state) const
     {
-      for(idx i = 0; i < setSize; ++i)
+      std::size_t seed = state.entries.hash();
+      compute_hash_combination(seed, state.lastEntry);
+
+      return seed;
+    }
+  };
+
+  /**
+   * Orders entries by their arrival times. Ties are broken by the
+   * last vertex, the set of vertices and the predecessor, so that
+   * the selection does not depend on the order of the entries.
+   **/
+  template <idx numWords>
+  struct CostCompare
+  {
+    bool operator()(const Entry<numWords>& first, const Entry<numWords>& second) const
+    {
+      if(first.arrivalTime != second.arrivalTime)
       {
-        if(not(first[i]) and second[i])
-        {
-          return true;
-        }
+        return first.arrivalTime < second.arrivalTime;
+      }
 
-        if(first[i] != second[i])
-        {
-          return false;
-        }
+      if(first.lastEntry != second.lastEntry)
+      {
+        return first.lastEntry < second.lastEntry;
       }
 
-      return false;
+      if(first.entries != second.entries)
+      {
+        return first.entries < second.entries;
+      }
+
+      return std::less<const Entry<numWords>*>{}(first.predecessor, second.predecessor);
     }
   };
 
-  struct SetCompare
+  /**
+   * Keeps the best candidates with respect to
+   * CostCompare up to a given capacity in a max-heap.
+   **/
+  template <idx numWords>
+  class BoundedCandidates
   {
-    bool operator()(const Entry& first, const Entry& second) const
+  private:
+    std::vector<Entry<numWords>> heap;
+    idx capacity;
+
+  public:
+    BoundedCandidates(idx capacity)
+      : capacity(capacity)
+    {}
+
+    bool full() const
+    {
+      return heap.size() >= capacity;
+    }
+
+    const Entry<numWords>& worst() const
+    {
+      assert(!heap.empty());
+      return heap.front();
+    }
+
+    void insert(const Entry<numWords>& predecessor,
+                idx lastEntry,
+                num arrivalTime)
     {
-      if(first.entries == second.entries)
+      if(!full())
       {
-        return first.arrivalTime < second.arrivalTime;
+        heap.push_back(Entry<numWords>(predecessor, lastEntry, arrivalTime));
+        std::push_heap(heap.begin(), heap.end(), CostCompare<numWords>{});
+        return;
+      }
+
+      if(arrivalTime > worst().arrivalTime)
+      {
+        return;
       }
 
-      return BitSetCompare{}(first.entries, second.entries);
+      Entry<numWords> entry(predecessor, lastEntry, arrivalTime);
+
+      if(CostCompare<numWords>{}(entry, worst()))
+      {
+        std::pop_heap(heap.begin(), heap.end(), CostCompare<numWords>{});
+        heap.back() = entry;
+        std::push_heap(heap.begin(), heap.end(), CostCompare<numWords>{});
+      }
+    }
+
+    void clear()
+    {
+      heap.clear();
+    }
+
+    const std::vector<Entry<numWords>>& getEntries() const
+    {
+      return heap;
     }
   };
+
+  void updateMinimum(std::atomic<num>& value, num candidate)
+  {
+    num current = value.load(std::memory_order_relaxed);
+
+    while(candidate < current and
+          !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+    {}
+  }
+
+  /**
+   * Merges the given buffers, each sorted with respect to CostCompare,
+   * and returns the best entries with pairwise distinct states, up to
+   * the given maximum size. The merge stops as soon as enough
+   * entries are found, most of the buffers are never touched.
+   **/
+  template <idx numWords>
+  std::vector<Entry<numWords>> selectEntries(const std::vector<std::vector<Entry<numWords>>>& buffers,
+                                             idx maxSize)
+  {
+    typedef ::Entry<numWords> Entry;
+    typedef ::CostCompare<numWords> CostCompare;
+
+    typedef std::pair<idx, idx> Position;
+
+    auto compare = [&](const Position& first, const Position& second) -> bool
+      {
+        return CostCompare{}(buffers[second.first][second.second],
+                             buffers[first.first][first.second]);
+      };
+
+    std::vector<Position> heads;
+
+    for(idx block = 0; block < buffers.size(); ++block)
+    {
+      if(!buffers[block].empty())
+      {
+        heads.push_back(Position(block, 0));
+      }
+    }
+
+    std::make_heap(heads.begin(), heads.end(), compare);
+
+    std::unordered_set<EntryState<numWords>, EntryStateHasher<numWords>> states;
+    std::vector<Entry> selected;
+
+    while(!heads.empty() and selected.size() < maxSize)
+    {
+      std::pop_heap(heads.begin(), heads.end(), compare);
+      Position& position = heads.back();
+
+      const Entry& entry = buffers[position.first][position.second];
+
+      if(states.insert(EntryState<numWords>(entry)).second)
+      {
+        selected.push_back(entry);
+      }
+
+      if(++position.second < buffers[position.first].size())
+      {
+        std::push_heap(heads.begin(), heads.end(), compare);
+      }
+      else
+      {
+        heads.pop_back();
+      }
+    }
+
+    return selected;
+  }
 }
 
 RestrictedDynamicSolver::RestrictedDynamicSolver(const Graph& graph,
                                                  const std::vector<Vertex>& vertices,
-                                                 idx maxSize)
+                                                 idx maxSize,
+                                                 idx numThreads)
   : graph(graph),
     vertices(vertices),
-    maxSize(maxSize)
+    maxSize(maxSize),
+    numThreads(std::max(numThreads, (idx) 1))
 {}
 
 Tour RestrictedDynamicSolver::findTour(TimedDistanceFunc& timedDistances)
 {
+  const idx size = vertices.size();
+
+  if(size <= 1*wordSize)
+  {
+    return findTour<1>(timedDistances);
+  }
+  else if(size <= 2*wordSize)
+  {
+    return findTour<2>(timedDistances);
+  }
+  else if(size <= 3*wordSize)
+  {
+    return findTour<3>(timedDistances);
+  }
+  else if(size <= 4*wordSize)
+  {
+    return findTour<4>(timedDistances);
+  }
+  else if(size <= 8*wordSize)
+  {
+    return findTour<8>(timedDistances);
+  }
+  else if(size <= 16*wordSize)
+  {
+    return findTour<16>(timedDistances);
+  }
+
+  throw std::invalid_argument("Too many vertices for a restricted dynamic program");
+}
+
+template <idx numWords>
+Tour RestrictedDynamicSolver::findTour(TimedDistanceFunc& timedDistances)
+{
+  typedef ::Entry<numWords> Entry;
+  typedef ::CostCompare<numWords> CostCompare;
+
   std::vector<Entry> initialEntries;
 
   /*
@@ -131,83 +422,123 @@ Tour RestrictedDynamicSolver::findTour(TimedDistanceFunc& timedDistances)
 
     assert(lastEntries.begin()->entries.count() < vertices.size());
 
-    num upperBound = inf;
-
-    std::vector<Entry> nextEntries;
-    nextEntries.reserve(maxSize);
-
-    for(const Entry& lastEntry : lastEntries)
+    // Each entry is continued by at most maxSize candidates. If the
+    // candidates of any entry exceed maxSize, the arrival time of its
+    // worst candidate bounds the arrival times of all selected entries.
+    // The bound is not used in the first iteration, where all
+    // entries are kept regardless of their arrival times
+    std::atomic<num> upperBound(inf);
+    const bool bounded = (i > 0);
+
+    // Blocks of consecutive entries are continued in parallel,
+    // candidates are collected in one buffer per block
+    const idx numBlocks = std::min((idx) lastEntries.size(), 4*numThreads);
+
+    std::vector<std::vector<Entry>> buffers(numBlocks);
+
+    parallelFor(numBlocks,
+                [&](idx block)
+                {
+                  const idx first = (((std::size_t) block) * lastEntries.size()) / numBlocks;
+                  const idx last = (((std::size_t) block + 1) * lastEntries.size()) / numBlocks;
+
+                  std::vector<Entry>& buffer = buffers[block];
+
+                  BoundedCandidates<numWords> candidates(maxSize);
+
+                  // positions of the states in the buffer
+                  std::unordered_map<EntryState<numWords>, idx, EntryStateHasher<numWords>> positions;
+
+                  std::vector<idx> nextIndices;
+                  std::vector<Vertex> nextVertices;
+                  std::vector<num> travelTimes;
+
+                  for(idx k = first; k < last; ++k)
+                  {
+                    const Entry& lastEntry = lastEntries[k];
+
+                    candidates.clear();
+                    nextIndices.clear();
+                    nextVertices.clear();
+
+                    for(idx next = 0; next < vertices.size(); ++next)
+                    {
+                      if(!lastEntry.entries[next])
+                      {
+                        nextIndices.push_back(next);
+                        nextVertices.push_back(vertices[next]);
+                      }
+                    }
+
+                    // query all unvisited vertices at once
+                    travelTimes.resize(nextVertices.size());
+
+                    timedDistances.distances(vertices[lastEntry.lastEntry],
+                                             lastEntry.arrivalTime,
+                                             nextVertices,
+                                             travelTimes);
+
+                    for(idx j = 0; j < nextIndices.size(); ++j)
+                    {
+                      const num arrivalTime = lastEntry.arrivalTime + travelTimes[j];
+
+                      if(bounded and arrivalTime > upperBound.load(std::memory_order_relaxed))
+                      {
+                        continue;
+                      }
+
+                      candidates.insert(lastEntry, nextIndices[j], arrivalTime);
+                    }
+
+                    if(bounded and candidates.full())
+                    {
+                      updateMinimum(upperBound, candidates.worst().arrivalTime);
+                    }
+
+                    // keep only the earliest arrival for each state
+                    for(const Entry& candidate : candidates.getEntries())
+                    {
+                      auto result = positions.insert(std::make_pair(EntryState<numWords>(candidate),
+                                                                    (idx) buffer.size()));
+
+                      if(result.second)
+                      {
+                        buffer.push_back(candidate);
+                      }
+                      else
+                      {
+                        Entry& existing = buffer[result.first->second];
+
+                        if(CostCompare{}(candidate, existing))
+                        {
+                          existing = candidate;
+                        }
+                      }
+                    }
+                  }
+
+                  std::sort(buffer.begin(), buffer.end(), CostCompare{});
+                },
+                numThreads);
+
+    std::size_t numCandidates = 0;
+
+    for(const std::vector<Entry>& buffer : buffers)
     {
-      std::set<Entry, CostCompare> bestCandidates;
-
-      for(idx next = 0; next < vertices.size(); ++next)
-      {
-        if(lastEntry.entries[next])
-        {
-          continue;
-        }
-
-        num arrivalTime = lastEntry.arrivalTime + timedDistances(vertices[lastEntry.lastEntry],
-                                                                 vertices[next],
-                                                                 lastEntry.arrivalTime);
-
-        if(arrivalTime <= upperBound)
-        {
-          Entry nextEntry(lastEntry, next, arrivalTime);
-          bestCandidates.insert(nextEntry);
-
-          if(bestCandidates.size() >= maxSize)
-          {
-            auto it = bestCandidates.begin();
-            std::advance(it, maxSize);
-            upperBound = std::min(upperBound, it->arrivalTime);
-          }
-        }
-      }
-
-      nextEntries.insert(nextEntries.begin(), bestCandidates.begin(), bestCandidates.end());
-    }
-
-    assert(nextEntries.size() >= std::min(maxSize, (idx) lastEntries.size()));
-
-    if(nextEntries.size() <= maxSize or i == 0)
-    {
-      allEntries.push_back(std::move(nextEntries));
-      continue;
+      numCandidates += buffer.size();
     }
 
-    std::sort(nextEntries.begin(), nextEntries.end(), SetCompare{});
-
-    auto last = nextEntries.begin();
-    auto it = last;
-    ++it;
-
-    std::vector<Entry> bestEntries;
+    Log(info) << "Generated " << numCandidates << " candidates";
 
-    bestEntries.push_back(*last);
+    // All candidates of the first iteration are kept
+    const idx numSelected = (i == 0) ? numCandidates : maxSize;
 
-    for(;it != nextEntries.end();++it)
-    {
-      if(last->entries != it->entries)
-      {
-        bestEntries.push_back(*it);
-      }
-
-      last = it;
-    }
-
-    if(bestEntries.size() > maxSize)
-    {
-      std::sort(bestEntries.begin(), bestEntries.end(), CostCompare{});
-      bestEntries.resize(maxSize, Entry(0));
-    }
-
-    allEntries.push_back(std::move(bestEntries));
+    allEntries.push_back(selectEntries(buffers, numSelected));
   }
 
   const std::vector<Entry> &lastEntries = *(allEntries.rbegin());
   num bestTime = inf;
-  Entry bestEntry(0);
+  const Entry* bestEntry = nullptr;
 
   for(const Entry& entry : lastEntries)
   {
@@ -219,14 +550,18 @@ Tour RestrictedDynamicSolver::findTour(TimedDistanceFunc& timedDistances)
                                                          *(entryVertices.begin()),
                                                          entry.arrivalTime);
 
-    if (arrivalTime < bestTime)
+    if(!bestEntry or
+       arrivalTime < bestTime or
+       (arrivalTime == bestTime and CostCompare{}(entry, *bestEntry)))
     {
       bestTime = arrivalTime;
-      bestEntry = entry;
+      bestEntry = &entry;
     }
   }
 
-  std::vector<Vertex> bestVertices = bestEntry.getVertices(vertices);
+  assert(bestEntry);
+
+  std::vector<Vertex> bestVertices = bestEntry->getVertices(vertices);
 
   assert(bestVertices.size() == vertices.size());
 
@@ -9,12 +9,19 @@
 
 #include "tour/tour.hh"
 
+#include "parallel.hh"
+
 /**
  * This solver solves the dynamic programming formulation
  * for the TSP but disregards seemingly suboptimal tours.
  *
  * See: "A restricted dynamic programming heuristic algorithm
  *       for the time dependent traveling salesman problem"
+ *
+ * The entries of each iteration are continued in parallel,
+ * the result does not depend on the number of threads. Sets of
+ * visited vertices are stored in as few words as possible,
+ * the number of vertices is limited to 1024.
  **/
 class RestrictedDynamicSolver
 {
@@ -22,12 +29,22 @@ private:
   const Graph& graph;
   const std::vector<Vertex>& vertices;
   idx maxSize;
+  idx numThreads;
+
+  template <idx numWords>
+  Tour findTour(TimedDistanceFunc& timedDistances);
 
 public:
   RestrictedDynamicSolver(const Graph& graph,
                           const std::vector<Vertex>& vertices,
-                          idx maxSize = 10);
+                          idx maxSize = 10,
+                          idx numThreads = 1);
 
+  /**
+   * Finds a tour with respect to the given distances, which
+   * must support concurrent queries if more than one thread
+   * is used.
+   **/
   Tour findTour(TimedDistanceFunc& timedDistances);
 };
 
@@ -1,131 +1,189 @@
 #include "shifting_solver.hh"
 
+#include <mutex>
+
+#include "log.hh"
 
 ShiftingSolver::ShiftingSolver(const Graph& graph,
-                               TimedDistanceFunc& distances)
+                               TimedDistanceFunc& distances,
+                               idx numThreads)
   : graph(graph),
     distances(distances),
-    evaluator(distances)
+    evaluator(distances),
+    numThreads(std::max(numThreads, (idx) 1))
 {}
 
-std::vector<Vertex> ShiftingSolver::flip(const std::vector<Vertex>& vertices,
-                                         ShiftingSolver::Iterator first,
-                                         ShiftingSolver::Iterator second) const
+void ShiftingSolver::flip(ShiftingSolver::Iterator first,
+                          ShiftingSolver::Iterator second,
+                          std::vector<Vertex>& middleVertices) const
 {
   assert(first < second);
 
-  std::vector<Vertex> nextVertices;
-  nextVertices.reserve(vertices.size());
-
-  nextVertices.insert(std::end(nextVertices),
-                      std::begin(vertices),
-                      first);
-
-  nextVertices.insert(std::end(nextVertices),
-                      std::reverse_iterator<decltype(second)>(second),
-                      std::reverse_iterator<decltype(first)>(first));
+  middleVertices.clear();
 
-  nextVertices.insert(std::end(nextVertices),
-                      second,
-                      std::end(vertices));
-
-  assert(nextVertices.size() == vertices.size());
-
-  return nextVertices;
+  middleVertices.insert(std::end(middleVertices),
+                        std::reverse_iterator<decltype(second)>(second),
+                        std::reverse_iterator<decltype(first)>(first));
 }
 
-std::vector<Vertex> ShiftingSolver::swap(const std::vector<Vertex>& vertices,
-                                         ShiftingSolver::Iterator first,
-                                         ShiftingSolver::Iterator second) const
+void ShiftingSolver::swap(ShiftingSolver::Iterator first,
+                          ShiftingSolver::Iterator second,
+                          std::vector<Vertex>& middleVertices) const
 {
   assert(first < second);
 
-  std::vector<Vertex> nextVertices;
-  nextVertices.reserve(vertices.size());
-
-  nextVertices.insert(std::end(nextVertices),
-                      std::begin(vertices),
-                      first);
+  middleVertices.clear();
 
-  nextVertices.push_back(*second);
+  middleVertices.push_back(*second);
 
   {
     auto it = first;
     ++it;
 
-    nextVertices.insert(std::end(nextVertices),
-                        it,
-                        second);
+    middleVertices.insert(std::end(middleVertices),
+                          it,
+                          second);
   }
 
-  nextVertices.push_back(*first);
+  middleVertices.push_back(*first);
+}
+
+bool ShiftingSolver::findMove(const ArrivalTimes<>& arrivalTimes,
+                              const std::vector<Vertex>& vertices,
+                              idx position,
+                              idx index,
+                              const std::atomic<idx>& found,
+                              Move& move) const
+{
+  const num currentCost = arrivalTimes.cost();
+
+  std::vector<Vertex>& middleVertices = move.vertices;
+  middleVertices.reserve(vertices.size());
+
+  const Iterator begin = std::begin(vertices);
+
+  const Iterator first = begin + position;
 
+  auto second = first;
+  ++second;
+
+  for(; second != std::end(vertices); ++second)
   {
-    auto it = second;
-    ++it;
+    if(found < index)
+    {
+      return false;
+    }
 
-    nextVertices.insert(std::end(nextVertices),
-                        it,
-                        std::end(vertices));
-  }
+    const idx secondPosition = std::distance(begin, second);
+
+    {
+      swap(first, second, middleVertices);
+
+      num nextCost = arrivalTimes.evaluate(position,
+                                           secondPosition + 1,
+                                           std::begin(middleVertices),
+                                           std::end(middleVertices));
+
+      if(nextCost < currentCost)
+      {
+        move.first = position;
+        move.last = secondPosition + 1;
+        move.cost = nextCost;
+        return true;
+      }
+    }
 
-  assert(nextVertices.size() == vertices.size());
+    {
+      flip(first, second, middleVertices);
+
+      num nextCost = arrivalTimes.evaluate(position,
+                                           secondPosition,
+                                           std::begin(middleVertices),
+                                           std::end(middleVertices));
+
+      if(nextCost < currentCost)
+      {
+        move.first = position;
+        move.last = secondPosition;
+        move.cost = nextCost;
+        return true;
+      }
+    }
+  }
 
-  return nextVertices;
+  return false;
 }
 
 bool ShiftingSolver::improve(std::vector<Vertex>& bestVertices,
                              num& bestCost,
-                             idx& distance) const
+                             idx& distance,
+                             ThreadPool& pool) const
 {
-  TimedDistanceEvaluator evaluator(distances);
+  const idx size = bestVertices.size();
 
-  std::vector<Vertex> currentVertices;
-  currentVertices.reserve(bestVertices.size());
+  if(distance >= size)
+  {
+    return false;
+  }
 
-  auto first = std::begin(bestVertices);
-  std::advance(first, distance);
+  const ArrivalTimes<> arrivalTimes(evaluator, bestVertices);
 
-  for(;first != std::end(bestVertices); ++first, ++distance)
-  {
-    auto second = first;
-    ++second;
+  assert(arrivalTimes.cost() == bestCost);
 
-    for(; second != std::end(bestVertices); ++second)
-    {
+  // Moves are split by the position of the first vertex
+  const idx numPositions = size - distance;
 
-      {
-        auto nextVertices = swap(bestVertices, first, second);
+  // One move per thread whose vertices are reused as a buffer,
+  // only the best move found so far is kept
+  std::vector<Move> moves(pool.numThreads());
 
-        Tour nextTour(graph, nextVertices);
-        num nextCost = evaluator(nextTour);
+  std::mutex bestMutex;
+  idx bestIndex = numPositions;
+  Move move;
 
-        if(nextCost < bestCost)
-        {
-          bestCost = nextCost;
-          bestVertices = nextVertices;
-          return true;
-        }
-      }
+  const idx index = parallelFindFirst(pool,
+                                      numPositions,
+                                      [&](idx index, const std::atomic<idx>& found) -> bool
+                                      {
+                                        Move& currentMove = moves[pool.threadIndex()];
 
-      {
+                                        if(!findMove(arrivalTimes,
+                                                     bestVertices,
+                                                     distance + index,
+                                                     index,
+                                                     found,
+                                                     currentMove))
+                                        {
+                                          return false;
+                                        }
 
-        auto nextVertices = flip(bestVertices, first, second);
+                                        std::lock_guard<std::mutex> guard(bestMutex);
 
-        Tour nextTour(graph, nextVertices);
-        num nextCost = evaluator(nextTour);
+                                        if(index < bestIndex)
+                                        {
+                                          bestIndex = index;
+                                          move = currentMove;
+                                        }
 
-        if(nextCost < bestCost)
-        {
-          bestCost = nextCost;
-          bestVertices = nextVertices;
-          return true;
-        }
-      }
-    }
+                                        return true;
+                                      });
+
+  if(index == numPositions)
+  {
+    distance = size;
+    return false;
   }
 
-  return false;
+  assert(index == bestIndex);
+
+  std::copy(std::begin(move.vertices),
+            std::end(move.vertices),
+            std::begin(bestVertices) + move.first);
+
+  bestCost = move.cost;
+  distance = move.first;
+
+  return true;
 }
 
 Tour ShiftingSolver::findTour(const Tour& initialTour)
@@ -137,11 +195,13 @@ Tour ShiftingSolver::findTour(const Tour& initialTour)
 
   idx distance = 1;
 
+  ThreadPool pool(numThreads);
+
   while(true)
   {
     std::vector<Vertex> currentVertices = bestVertices;
 
-    if(improve(currentVertices, bestCost, distance))
+    if(improve(currentVertices, bestCost, distance, pool))
     {
       bestVertices = currentVertices;
       Log(info) << "Tour costs dropped to " << bestCost;
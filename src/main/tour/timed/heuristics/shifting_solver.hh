@@ -6,7 +6,19 @@
 #include "timed/timed_vertex_func.hh"
 
 #include "tour/tour.hh"
+#include "tour/heuristics/arrival_times.hh"
 
+#include "parallel.hh"
+
+/**
+ * A local search swapping pairs of vertices and flipping the
+ * segments between them. The moves of each step can be evaluated
+ * in parallel by threads which are reused across all steps, the
+ * distances must support concurrent queries if more than one thread
+ * is used. Each step performs the first improving move with respect
+ * to a sequential scan, the result does not depend on the number
+ * of threads.
+ **/
 class ShiftingSolver
 {
 private:
@@ -14,24 +26,52 @@ private:
   const Graph& graph;
   TimedDistanceFunc& distances;
   TimedDistanceEvaluator evaluator;
+  idx numThreads;
 
   typedef std::vector<Vertex>::const_iterator Iterator;
 
-  std::vector<Vertex> flip(const std::vector<Vertex>& vertices,
-                           Iterator begin,
-                           Iterator end) const;
+  /**
+   * A move replacing the vertices in the range [first, last)
+   * of the current tour by the given vertices.
+   **/
+  struct Move
+  {
+    idx first;
+    idx last;
+    num cost;
+    std::vector<Vertex> vertices;
+  };
+
+  void flip(Iterator begin,
+            Iterator end,
+            std::vector<Vertex>& middleVertices) const;
+
+  void swap(Iterator begin,
+            Iterator end,
+            std::vector<Vertex>& middleVertices) const;
 
-  std::vector<Vertex> swap(const std::vector<Vertex>& vertices,
-                           Iterator begin,
-                           Iterator end) const;
+  /**
+   * Finds the first improving move of the vertex at the given position
+   * with any later vertex. Gives up once an improving move of an earlier
+   * position (at an index less than the given one) has been found.
+   * The vertices of the given move are used as a buffer.
+   **/
+  bool findMove(const ArrivalTimes<>& arrivalTimes,
+                const std::vector<Vertex>& vertices,
+                idx position,
+                idx index,
+                const std::atomic<idx>& found,
+                Move& move) const;
 
   bool improve(std::vector<Vertex>& bestVertices,
                num& bestCost,
-               idx& distance) const;
+               idx& distance,
+               ThreadPool& pool) const;
 
 public:
   ShiftingSolver(const Graph& graph,
-                 TimedDistanceFunc& distances);
+                 TimedDistanceFunc& distances,
+                 idx numThreads = 1);
 
   Tour findTour(const Tour& initialTour);
 };
@@ -0,0 +1,92 @@
+#include "timed_candidate_lists.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+TimedCandidateLists::TimedCandidateLists(const Graph& graph,
+                                         const std::vector<Vertex>& vertices,
+                                         TimedDistanceFunc& distances,
+                                         idx timeHorizon,
+                                         idx numWindows,
+                                         idx numCandidates,
+                                         idx numThreads)
+  : vertices(vertices),
+    positions(graph, (idx) -1),
+    windowLength(0),
+    numWindows(numWindows)
+{
+  if(numWindows == 0 or timeHorizon < numWindows)
+  {
+    throw std::invalid_argument("Invalid number of time windows");
+  }
+
+  windowLength = (timeHorizon + numWindows - 1) / numWindows;
+
+  const idx size = vertices.size();
+
+  for(idx i = 0; i < size; ++i)
+  {
+    positions(vertices[i]) = i;
+  }
+
+  numCandidates = std::min(numCandidates, size > 0 ? size - 1 : 0);
+
+  lists.resize(numWindows * size);
+
+  parallelFor(numWindows * size,
+              [&](idx index)
+              {
+                const idx window = index / size;
+                const Vertex& source = vertices[index % size];
+
+                std::vector<num> values(size);
+
+                distances.distances(source,
+                                    window * windowLength,
+                                    vertices,
+                                    values);
+
+                std::vector<idx> order;
+                order.reserve(size);
+
+                for(idx i = 0; i < size; ++i)
+                {
+                  if(vertices[i] != source)
+                  {
+                    order.push_back(i);
+                  }
+                }
+
+                // Ties are broken by the position of the vertex
+                std::partial_sort(std::begin(order),
+                                  std::begin(order) + numCandidates,
+                                  std::end(order),
+                                  [&](idx first, idx second) -> bool
+                                  {
+                                    return (values[first] < values[second]) or
+                                      (values[first] == values[second] and first < second);
+                                  });
+
+                std::vector<Vertex>& list = lists[index];
+                list.reserve(numCandidates);
+
+                for(idx i = 0; i < numCandidates; ++i)
+                {
+                  list.push_back(vertices[order[i]]);
+                }
+              },
+              numThreads);
+}
+
+const std::vector<Vertex>& TimedCandidateLists::operator()(const Vertex& source,
+                                                           idx departureTime) const
+{
+  const idx position = positions(source);
+
+  if(position == (idx) -1)
+  {
+    throw std::out_of_range("Unknown source vertex");
+  }
+
+  return lists[window(departureTime) * vertices.size() + position];
+}
@@ -0,0 +1,56 @@
+#ifndef TIMED_CANDIDATE_LISTS_HH
+#define TIMED_CANDIDATE_LISTS_HH
+
+#include <algorithm>
+#include <vector>
+
+#include "graph/graph.hh"
+#include "graph/vertex_map.hh"
+
+#include "timed/timed_vertex_func.hh"
+
+#include "parallel.hh"
+
+/**
+ * Precomputed candidate lists for time-dependent local search.
+ * The time horizon is split into windows of equal length. For each
+ * of the given vertices and each window, the list contains the given
+ * number of other vertices which are closest to the vertex when
+ * departing at the beginning of the window, ordered by distance.
+ * Departure times beyond the horizon use the last window.
+ *
+ * The lists are computed in parallel, the distances must support
+ * concurrent queries if more than one thread is used.
+ **/
+class TimedCandidateLists
+{
+private:
+  std::vector<Vertex> vertices;
+  VertexMap<idx> positions;
+  idx windowLength;
+  idx numWindows;
+  std::vector<std::vector<Vertex>> lists;
+
+  idx window(idx departureTime) const
+  {
+    return std::min(departureTime / windowLength, numWindows - 1);
+  }
+
+public:
+  TimedCandidateLists(const Graph& graph,
+                      const std::vector<Vertex>& vertices,
+                      TimedDistanceFunc& distances,
+                      idx timeHorizon,
+                      idx numWindows,
+                      idx numCandidates,
+                      idx numThreads = 1);
+
+  /**
+   * Returns the closest vertices to the given source when departing
+   * within the window containing the given departure time.
+   **/
+  const std::vector<Vertex>& operator()(const Vertex& source,
+                                        idx departureTime) const;
+};
+
+#endif /* TIMED_CANDIDATE_LISTS_HH */
@@ -8,216 +8,334 @@
 TimedLKHSolver::TimedLKHSolver(const Graph& graph,
                                const std::vector<Vertex>& vertices,
                                TimedDistanceFunc& distances,
-                               ScoreFunction scoreFunction)
+                               ScoreFunction scoreFunction,
+                               std::shared_ptr<const TimedCandidateLists> candidateLists)
   : graph(graph),
     vertices(vertices),
     backTracingSteps(5),
     maxCandidates(5),
     distances(distances),
-    scoreFunction(scoreFunction)
+    scoreFunction(scoreFunction),
+    candidateLists(candidateLists)
 {
 }
 
-template<class It>
-std::vector<Vertex> TimedLKHSolver::getCandidates(const num currentTime,
-                                                  const Vertex currentVertex,
-                                                  It it,
-                                                  It end) const
+void TimedLKHSolver::getCandidates(const num currentTime,
+                                   const num departureTime,
+                                   const std::vector<Vertex>& tourVertices,
+                                   const VertexMap<idx>& positions,
+                                   idx headSize,
+                                   std::vector<Vertex>& candidates) const
 {
-  assert(it < end);
+  assert(0 < headSize and headSize < tourVertices.size());
 
-  Vertex nextVertex = *it;
+  const Vertex currentVertex = tourVertices[headSize - 1];
+  const Vertex nextVertex = tourVertices[headSize];
 
   num nextScore = scoreFunction(currentVertex, nextVertex, nextVertex, currentTime);
 
-  ++it;
+  std::vector<std::pair<double, Vertex>> scoredCandidates;
 
-  std::vector<Vertex> candidates;
-
-  for(;it != end; ++it)
-  {
-
-    Vertex candidate = *it;
+  auto addCandidate = [&](const Vertex& candidate)
+    {
+      double candidateScore = scoreFunction(currentVertex, nextVertex, candidate, currentTime);
 
-    num candidateScore = scoreFunction(currentVertex, nextVertex, candidate, currentTime);
+      if((num) candidateScore < nextScore)
+      {
+        scoredCandidates.push_back(std::make_pair(candidateScore, candidate));
+      }
+    };
 
-    if(candidateScore < nextScore)
+  if(candidateLists)
+  {
+    for(const Vertex& candidate : (*candidateLists)(currentVertex, departureTime))
     {
-      candidates.push_back(candidate);
+      if(positions(candidate) > headSize)
+      {
+        addCandidate(candidate);
+      }
+    }
+  }
+  else
+  {
+    for(idx i = headSize + 1; i < tourVertices.size(); ++i)
+    {
+      addCandidate(tourVertices[i]);
     }
   }
 
-  std::sort(candidates.begin(), candidates.end(),
-            [&](const Vertex& first, const Vertex& second) -> bool
+  std::sort(scoredCandidates.begin(), scoredCandidates.end(),
+            [&](const std::pair<double, Vertex>& first,
+                const std::pair<double, Vertex>& second) -> bool
             {
-              return scoreFunction(currentVertex, nextVertex, first, currentTime)
-                < scoreFunction(currentVertex, nextVertex, second, currentTime);
+              return first.first < second.first;
             });
 
-  if(candidates.size() > maxCandidates)
+  if(scoredCandidates.size() > maxCandidates)
   {
-    candidates.resize(maxCandidates);
+    scoredCandidates.resize(maxCandidates);
   }
 
-  assert(candidates.size() <= maxCandidates);
+  candidates.clear();
+
+  for(const auto& scoredCandidate : scoredCandidates)
+  {
+    candidates.push_back(scoredCandidate.second);
+  }
 
-  return candidates;
+  assert(candidates.size() <= maxCandidates);
 }
 
-void TimedLKHSolver::improve(std::vector<Vertex> head,
-                             std::deque<Vertex> tail,
-                             Tour& bestTour,
-                             const num currentTime,
-                             const idx steps) const
+num TimedLKHSolver::evaluate(const std::vector<Vertex>& tourVertices,
+                             const std::vector<num>& initialArrivalTimes,
+                             idx headSize,
+                             idx extent,
+                             num arrivalTime,
+                             num bestCost) const
 {
-  assert(not(head.empty()));
-  assert(head.size() + tail.size() == vertices.size());
-  assert(currentTime >= 0);
+  const idx size = tourVertices.size();
 
+  if(size <= 1)
   {
-    TimedDistanceEvaluator evaluator(distances);
-
-    std::vector<Vertex> nextVertices;
-
-    nextVertices.reserve(vertices.size());
+    return 0;
+  }
 
-    nextVertices.insert(nextVertices.end(), head.begin(), head.end());
-    nextVertices.insert(nextVertices.end(), tail.begin(), tail.end());
+  Vertex currentVertex = tourVertices[headSize - 1];
 
-    Tour nextTour(graph, nextVertices);
+  for(idx i = headSize; i < size; ++i)
+  {
+    // Travel times are non-negative
+    if(arrivalTime >= bestCost)
+    {
+      return arrivalTime;
+    }
 
-    const num bestCosts = evaluator(bestTour);
-    const num nextCosts = evaluator(nextTour);
+    arrivalTime += distances(currentVertex, tourVertices[i], arrivalTime);
+    currentVertex = tourVertices[i];
 
-    if(nextCosts < bestCosts)
+    // The remainder of the tour is traversed as in the initial one
+    if(i >= extent and arrivalTime == initialArrivalTimes[i])
     {
-      Log(info) << "Found improvement from " << bestCosts
-                << " to " << nextCosts
-                << " after a series of " << steps
-                << " 2-opt moves";
-
-      bestTour = nextTour;
+      return initialArrivalTimes[size];
     }
   }
 
-  if(tail.empty())
-  {
-    return;
-  }
+  return arrivalTime + distances(currentVertex, tourVertices[0], arrivalTime);
+}
 
-  Vertex currentVertex = *(head.rbegin());
+void TimedLKHSolver::improve(std::vector<Vertex>& tourVertices,
+                             VertexMap<idx>& positions,
+                             const std::vector<num>& initialArrivalTimes,
+                             std::vector<num>& arrivalTimes,
+                             const idx headSize,
+                             Tour& bestTour,
+                             std::atomic<num>& bestCost,
+                             const std::function<bool()>& stopped) const
+{
+  const idx size = tourVertices.size();
 
-  std::vector<Vertex> candidates = getCandidates(currentTime,
-                                                 currentVertex,
-                                                 tail.begin(),
-                                                 tail.end());
+  assert(headSize > 0 and headSize <= size);
+  assert(size == vertices.size());
+  assert(initialArrivalTimes.size() == size + 1);
+  assert(arrivalTimes.size() == size + 1);
 
-  if(candidates.empty())
-  {
-    Vertex nextVertex = *(tail.begin());
+  std::vector<Frame> stack;
+  stack.reserve(size - headSize + 1);
 
-    head.push_back(nextVertex);
-    tail.pop_front();
+  // The candidates of the node at each depth, reused across nodes
+  std::vector<std::vector<Vertex>> candidates(size - headSize + 1);
 
-    num nextTime = currentTime + distances(currentVertex, nextVertex, currentTime);
+  const idx none = (idx) -1;
 
-    improve(head, tail, bestTour, nextTime, steps);
-  }
-  else
-  {
-    if(steps >= backTracingSteps)
+  // Reverses the given number of vertices from the
+  // given position on, keeping the positions up to date
+  auto reverse = [&](const idx begin, const idx length)
     {
-      Vertex nextVertex = *(candidates.begin());
+      const auto first = tourVertices.begin() + begin;
 
-      head.push_back(nextVertex);
+      std::reverse(first, first + length);
 
-      std::deque<Vertex> nextTail;
+      for(idx i = begin; i < begin + length; ++i)
+      {
+        positions(tourVertices[i]) = i;
+      }
+    };
 
-      reverseUntil(tail.begin(), tail.end(), nextVertex, nextTail);
+  // Visits the node at the depth of the stack size,
+  // pushing it if it needs to be expanded
+  auto visit = [&](const num currentTime, const idx steps, const idx extent)
+    {
+      assert(currentTime >= 0);
 
-      assert(nextTail.size() + 1 == tail.size());
+      const idx depth = stack.size();
+      const idx currentSize = headSize + depth;
 
-      num nextTime = currentTime + distances(currentVertex, nextVertex, currentTime);
+      const num arrivalTime = arrivalTimes[currentSize - 1];
 
-      improve(head, nextTail, bestTour, nextTime, steps + 1);
-    }
-    else
-    {
-      for(const Vertex& nextVertex : candidates)
+      // Travel times are non-negative, no completion of the head
+      // can improve on the best cost
+      if(arrivalTime >= bestCost or (stopped and stopped()))
+      {
+        return;
+      }
+
+      const num nextCosts = evaluate(tourVertices,
+                                     initialArrivalTimes,
+                                     currentSize,
+                                     extent,
+                                     arrivalTime,
+                                     bestCost);
+
+      num bestCosts = bestCost;
+
+      while(nextCosts < bestCosts and
+            !bestCost.compare_exchange_weak(bestCosts, nextCosts))
+      {}
+
+      if(nextCosts < bestCosts)
       {
-        std::vector<Vertex> nextHead;
+        Log(info) << "Found improvement from " << bestCosts
+                  << " to " << nextCosts
+                  << " after a series of " << steps
+                  << " 2-opt moves";
 
-        nextHead.reserve(head.size() + 1);
+        bestTour = Tour(graph, tourVertices);
+      }
 
-        for(const Vertex& headVertex : head)
-        {
-          nextHead.push_back(headVertex);
-        }
+      if(currentSize == size)
+      {
+        return;
+      }
 
-        nextHead.push_back(nextVertex);
+      std::vector<Vertex>& currentCandidates = candidates[depth];
 
-        std::deque<Vertex> nextTail;
+      getCandidates(currentTime,
+                    arrivalTime,
+                    tourVertices,
+                    positions,
+                    currentSize,
+                    currentCandidates);
 
-        reverseUntil(tail.begin(), tail.end(), nextVertex, nextTail);
+      // Without candidates the next tail vertex is moved to the head,
+      // after the given number of steps only the best candidate is tried
+      const idx numChildren = (currentCandidates.empty() or steps >= backTracingSteps)
+        ? 1
+        : currentCandidates.size();
 
-        assert(nextTail.size() + 1 == tail.size());
+      stack.push_back(Frame{currentTime, steps, numChildren, 0, none, extent});
+    };
 
-        num nextTime = currentTime + distances(currentVertex, nextVertex, currentTime);
+  visit(0, 0, headSize);
 
-        improve(nextHead, nextTail, bestTour, nextTime, steps + 1);
-      }
+  while(!stack.empty())
+  {
+    Frame& frame = stack.back();
+
+    const idx depth = stack.size() - 1;
+    const idx currentSize = headSize + depth;
+
+    // Undo the move of the previous child
+    if(frame.reversed != none)
+    {
+      reverse(currentSize, frame.reversed);
+      frame.reversed = none;
     }
-  }
-}
 
-template<class It>
-void TimedLKHSolver::reverseUntil(It begin,
-                                  It end,
-                                  const Vertex& vertex,
-                                  std::deque<Vertex>& result) const
-{
-  assert(begin < end);
+    if(frame.nextChild == frame.numChildren)
+    {
+      stack.pop_back();
+      continue;
+    }
 
-  It middle = std::find(begin, end, vertex);
+    const std::vector<Vertex>& currentCandidates = candidates[depth];
 
-  assert(middle < end);
+    const bool forced = currentCandidates.empty();
 
-  for(It current = begin; current != middle; ++current)
-  {
-    result.push_back(*current);
-  }
+    const Vertex currentVertex = tourVertices[currentSize - 1];
+    const Vertex nextVertex = forced ? tourVertices[currentSize] : currentCandidates[frame.nextChild];
 
-  std::reverse(result.begin(), result.end());
+    ++frame.nextChild;
 
-  ++middle;
+    // Move the next vertex to the front of the tail by reversing
+    // the tail prefix up to (and including) the vertex
+    const idx position = positions(nextVertex);
 
-  for(It current = middle; current != end; ++current)
-  {
-    result.push_back(*current);
+    assert(position >= currentSize and tourVertices[position] == nextVertex);
+
+    frame.reversed = position - currentSize + 1;
+
+    reverse(currentSize, frame.reversed);
+
+    const num nextTime = frame.currentTime
+      + distances(currentVertex, nextVertex, frame.currentTime);
+
+    const num arrivalTime = arrivalTimes[currentSize - 1];
+
+    arrivalTimes[currentSize] = arrivalTime
+      + distances(currentVertex, nextVertex, arrivalTime);
+
+    // The frame reference is invalidated by the visit
+    const idx nextSteps = forced ? frame.steps : frame.steps + 1;
+    const idx nextExtent = std::max(frame.extent, currentSize + frame.reversed);
+
+    visit(nextTime, nextSteps, nextExtent);
   }
 }
 
 Tour TimedLKHSolver::improveTour(const Tour& initialTour)
+{
+  TimedDistanceEvaluator evaluator(distances);
+
+  std::atomic<num> bestCost(evaluator(initialTour));
+
+  return improveTour(initialTour, bestCost);
+}
+
+Tour TimedLKHSolver::improveTour(const Tour& initialTour,
+                                 std::atomic<num>& bestCost,
+                                 const std::function<bool()>& stopped) const
 {
   Tour bestTour(initialTour);
 
-  const std::vector<Vertex> tourVertices = bestTour.getVertices();
+  std::vector<Vertex> tourVertices = bestTour.getVertices();
+
+  const idx size = tourVertices.size();
+
+  // The arrival times along the initial tour, the last
+  // one is the arrival time back at the source
+  std::vector<num> initialArrivalTimes(size + 1, 0);
 
-  for(idx i = 1; i < tourVertices.size(); ++i)
+  for(idx i = 1; i <= size; ++i)
   {
-    auto it = tourVertices.begin();
+    const num arrivalTime = initialArrivalTimes[i - 1];
 
-    std::vector<Vertex> head = {};
+    initialArrivalTimes[i] = arrivalTime
+      + distances(tourVertices[i - 1], tourVertices[i % size], arrivalTime);
+  }
 
-    for(idx j = 0; j < i; ++j)
-    {
-      head.push_back(*it);
-      ++it;
-    }
+  VertexMap<idx> positions(graph, 0);
 
-    std::deque<Vertex> tail(it, tourVertices.end());
+  for(idx i = 0; i < size; ++i)
+  {
+    positions(tourVertices[i]) = i;
+  }
 
-    improve(head, tail, bestTour);
+  std::vector<num> arrivalTimes;
+
+  for(idx i = 1; i < size; ++i)
+  {
+    arrivalTimes = initialArrivalTimes;
+
+    improve(tourVertices,
+            positions,
+            initialArrivalTimes,
+            arrivalTimes,
+            i,
+            bestTour,
+            bestCost,
+            stopped);
+
+    assert(tourVertices == initialTour.getVertices());
   }
 
   return bestTour;
@@ -1,14 +1,19 @@
 #ifndef TIMED_LKH_SOLVER_HH
 #define TIMED_LKH_SOLVER_HH
 
-#include <deque>
+#include <atomic>
+#include <functional>
+#include <memory>
 
 #include "graph/graph.hh"
+#include "graph/vertex_map.hh"
 
 #include "timed/timed_vertex_func.hh"
 
 #include "tour/tour.hh"
 
+#include "timed_candidate_lists.hh"
+
 class TimedLKHSolver
 {
 public:
@@ -20,33 +25,101 @@ private:
   idx maxCandidates;
   TimedDistanceFunc& distances;
   ScoreFunction scoreFunction;
+  std::shared_ptr<const TimedCandidateLists> candidateLists;
 
-  template<class It>
-  std::vector<Vertex> getCandidates(const num currentTime,
-                                    const Vertex currentVertex,
-                                    It begin,
-                                    It end) const;
+  /**
+   * Returns the tail vertices following the first one (at the given
+   * head size) which score better than it, ordered by their scores.
+   * If candidate lists are given, only the vertices of the list of
+   * the last head vertex when departing at the given time are
+   * considered rather than scanning the entire tail, using the
+   * positions of the vertices in the tour to decide whether they
+   * belong to the tail.
+   **/
+  void getCandidates(const num currentTime,
+                     const num departureTime,
+                     const std::vector<Vertex>& tourVertices,
+                     const VertexMap<idx>& positions,
+                     idx headSize,
+                     std::vector<Vertex>& candidates) const;
 
-  void improve(std::vector<Vertex> head,
-               std::deque<Vertex> tail,
-               Tour& bestTour,
-               const num currentTime = 0,
-               const idx steps = 0) const;
+  /**
+   * A node of the search, whose head consists of the first
+   * (initial head size + depth) vertices of the tour. Candidates are
+   * scored with respect to the time elapsed since the end of the
+   * initial head.
+   **/
+  struct Frame
+  {
+    num currentTime;
+    idx steps;
+    idx numChildren;
+    idx nextChild;
+    // The length of the tail prefix reversed by the current child
+    idx reversed;
+    // The tour agrees with the initial one from this position on
+    idx extent;
+  };
 
-  template<class It>
-  void reverseUntil(It begin,
-                    It end,
-                    const Vertex& vertex,
-                    std::deque<Vertex>& result) const;
+  /**
+   * Evaluates the tour consisting of the given head and tail, given
+   * the arrival time at the end of the head, stopping as soon as the
+   * tour cannot improve on the best cost. From the given extent on,
+   * the tour must agree with the initial one, whose arrival times
+   * (including the one back at the source) are given. Once the
+   * arrival time at a vertex beyond the extent agrees as well, the
+   * cost of the initial tour is returned. The cost of a node is
+   * thereby linear in the number of positions changed by the moves
+   * leading to it (and the vertices traversed until the arrival
+   * times agree) rather than in the size of the tour, although
+   * it remains linear in the worst case.
+   **/
+  num evaluate(const std::vector<Vertex>& tourVertices,
+               const std::vector<num>& initialArrivalTimes,
+               idx headSize,
+               idx extent,
+               num arrivalTime,
+               num bestCost) const;
+
+  /**
+   * Searches for improving tours in depth-first order on an explicit
+   * stack. Moving a tail vertex to the head reverses the tail prefix
+   * in front of it in place, the reversal is undone when backtracking.
+   * The positions of the vertices in the tour and the arrival times
+   * along the head are updated accordingly, initially the arrival
+   * times must be given for the initial head. The tour vertices and
+   * their positions are restored before returning.
+   **/
+  void improve(std::vector<Vertex>& tourVertices,
+               VertexMap<idx>& positions,
+               const std::vector<num>& initialArrivalTimes,
+               std::vector<num>& arrivalTimes,
+               idx headSize,
+               Tour& bestTour,
+               std::atomic<num>& bestCost,
+               const std::function<bool()>& stopped) const;
 
 public:
   TimedLKHSolver(const Graph& graph,
                  const std::vector<Vertex>& vertices,
                  TimedDistanceFunc& distances,
-                 ScoreFunction scoreFunction);
+                 ScoreFunction scoreFunction,
+                 std::shared_ptr<const TimedCandidateLists> candidateLists = nullptr);
 
   Tour improveTour(const Tour& initialTour);
 
+  /**
+   * Improves the given tour, sharing the cost of the best known tour
+   * with concurrent searches: Partial tours arriving no earlier than
+   * the best cost are pruned, only cheaper tours are accepted, lowering
+   * the best cost accordingly. Returns the initial tour if no tour
+   * cheaper than the best cost is found. The search is aborted as
+   * soon as the given function (if any) returns true.
+   **/
+  Tour improveTour(const Tour& initialTour,
+                   std::atomic<num>& bestCost,
+                   const std::function<bool()>& stopped = {}) const;
+
   static ScoreFunction relativeDistances(DistanceFunc& staticDistances,
                                          TimedDistanceFunc& distances);
 
@@ -14,7 +14,11 @@ SimpleProgram::SimpleProgram(const Tour& initialTour,
                              TimedDistanceFunc& distances,
                              const Program::Settings& settings)
   : Program("simple_timed_tour", settings),
-    graph(createTimeExpandedGraph(initialTour, distances)),
+    graph(createCachedTimeExpandedGraph(initialTour,
+                                        distances,
+                                        settings.graphCacheFile,
+                                        0,
+                                        settings.numThreads)),
     originalGraph(graph.underlyingGraph()),
     distances(distances),
     initialTour(initialTour),
@@ -87,6 +87,15 @@ class TourEvaluator
 {
 public:
   virtual T operator()(const Tour& tour) const = 0;
+
+  /**
+   * Returns the cost of traveling from the source to the target when
+   * departing at the given time. The cost of a tour equals the
+   * arrival time at its first vertex when departing there at time zero.
+   **/
+  virtual T travelTime(const Vertex& source,
+                       const Vertex& target,
+                       T departureTime) const = 0;
 };
 
 template<class T = num>
@@ -107,6 +116,20 @@ public:
   {
     return tour.cost(costs, router);
   }
+
+  T travelTime(const Vertex& source,
+               const Vertex& target,
+               T departureTime) const override
+  {
+    auto result = router.shortestPath(source, target, costs);
+
+    if(!result.found)
+    {
+      throw std::runtime_error("Graph is not strongly connected");
+    }
+
+    return result.path.cost(costs);
+  }
 };
 
 class TimedDistanceEvaluator : public TourEvaluator<num>
@@ -123,6 +146,13 @@ public:
   {
     return tour.cost(distances);
   }
+
+  num travelTime(const Vertex& source,
+                 const Vertex& target,
+                 num departureTime) const override
+  {
+    return distances(source, target, departureTime);
+  }
 };
 
 
@@ -29,7 +29,7 @@ SolutionResult PathBasedRelaxationBenchmark<Pricer>::execute(Instance& instance,
                         instance.timedDistances,
                         0.,
                         false,
-                        Program::Settings().collectStats().doSolveRelaxation());
+                        programSettings().doSolveRelaxation());
 
   program.setPricer(getPricer(program));
 
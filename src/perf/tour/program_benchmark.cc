@@ -1,12 +1,15 @@
 #include "program_benchmark.hh"
 
+#include <cstdio>
+#include <cstdlib>
 #include <sstream>
 #include <stdexcept>
 
+#include <unistd.h>
+
 #include <boost/program_options.hpp>
 namespace po = boost::program_options;
 
-#include "defs.hh"
 #include "defs.hh"
 #include "lp_observer.hh"
 
@@ -15,7 +18,7 @@ namespace po = boost::program_options;
 
 void ProgramBenchmark::executeAll(const std::vector<InstanceInfo>& instanceInfos)
 {
-  std::cout << "Size;Seed;initialTourCost;numExpandedVertices;numExpandedEdges;Time;primalBound;dualBound;gap;"
+  std::cout << "Size;Seed;initialTourCost;numExpandedVertices;numExpandedEdges;expansionTime;Time;primalBound;dualBound;gap;"
             << "estimatedTreeSize;maxDepth;numIterations;numNodes;numVariables;"
             << "numConstraints;LPRootObjVal;rootLPSolved;rootNodeSolvingTime;"
             << "firstLPTime;firstDualBoundRoot;firstLowerBoundRoot;"
@@ -31,6 +34,24 @@ void ProgramBenchmark::executeAll(const std::vector<InstanceInfo>& instanceInfos
 
     Tour initialTour = simpleSolver.findTour();
 
+    // Expand the graph once, the programs read it from the cache
+    graphCacheFile = cacheFilePath(instanceInfo);
+
+    if(graphCacheDirectory.empty())
+    {
+      std::remove(graphCacheFile.c_str());
+    }
+
+    Timer expansionTimer;
+
+    TimeExpandedGraph expandedGraph = createCachedTimeExpandedGraph(initialTour,
+                                                                    instance.timedDistances,
+                                                                    graphCacheFile);
+
+    const double expansionTime = expansionTimer.elapsed();
+
+    const Graph& graph = expandedGraph;
+
     idx timeLimit = 3600;
 
     Timer timer;
@@ -39,18 +60,17 @@ void ProgramBenchmark::executeAll(const std::vector<InstanceInfo>& instanceInfos
 
     const double elapsed = timer.elapsed();
 
+    if(graphCacheDirectory.empty())
+    {
+      std::remove(graphCacheFile.c_str());
+    }
+
     TimedDistanceEvaluator evaluator(instance.timedDistances);
 
     const double initialTourCost = evaluator(initialTour);
 
     const SolutionStats& stats = result.stats;
 
-
-    TimeExpandedGraph expandedGraph = createTimeExpandedGraph(initialTour,
-                                                              instance.timedDistances);
-
-    const Graph& graph = expandedGraph;
-
     std::cout << instanceInfo.numVertices
               << ";"
               << instanceInfo.seed
@@ -61,6 +81,8 @@ void ProgramBenchmark::executeAll(const std::vector<InstanceInfo>& instanceInfos
               << ";"
               << graph.getEdges().size()
               << ";"
+              << expansionTime
+              << ";"
               << std::min(elapsed, (double) timeLimit)
               << ";"
               << stats.primalBound
@@ -114,6 +136,33 @@ void ProgramBenchmark::executeAll(const std::vector<InstanceInfo>& instanceInfos
   }
 }
 
+std::string ProgramBenchmark::cacheFilePath(const InstanceInfo& instanceInfo) const
+{
+  std::ostringstream namebuf;
+
+  // Without a cache directory, use a temporary file per instance
+  if(graphCacheDirectory.empty())
+  {
+    const char* directory = std::getenv("TMPDIR");
+
+    namebuf << ((directory != nullptr) ? directory : "/tmp")
+            << "/graph_"
+            << getpid()
+            << ".bin";
+  }
+  else
+  {
+    namebuf << graphCacheDirectory
+            << "/graph_"
+            << instanceInfo.numVertices
+            << "_"
+            << instanceInfo.seed
+            << ".bin";
+  }
+
+  return namebuf.str();
+}
+
 std::string ProgramBenchmark::setFilePath(const std::string& name)
 {
   std::ostringstream namebuf;
@@ -139,7 +188,8 @@ void ProgramBenchmark::run(int argc, char *argv[])
 
   desc.add_options()
     ("help", "produce help message")
-    ("size", po::value<std::string>(), "size ");
+    ("size", po::value<std::string>(), "size ")
+    ("graph_cache", po::value<std::string>(), "directory to keep time-expanded graphs in across runs");
 
   po::variables_map vm;
   po::store(po::command_line_parser(argc, argv)
@@ -154,6 +204,11 @@ void ProgramBenchmark::run(int argc, char *argv[])
     return;
   }
 
+  if(vm.count("graph_cache"))
+  {
+    graphCacheDirectory = vm["graph_cache"].as<std::string>();
+  }
+
   std::vector<InstanceInfo> instanceInfos;
 
   std::string size = "small";
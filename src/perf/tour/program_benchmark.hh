@@ -1,6 +1,10 @@
 #ifndef PROGRAM_BENCHMARK_HH
 #define PROGRAM_BENCHMARK_HH
 
+#include <string>
+
+#include "program.hh"
+
 #include "tour/tour.hh"
 #include "tour/solution_result.hh"
 
@@ -10,11 +14,29 @@
 
 class ProgramBenchmark
 {
+private:
+  std::string graphCacheDirectory;
+  std::string graphCacheFile;
+
+  std::string cacheFilePath(const InstanceInfo& instanceInfo) const;
+
 protected:
   virtual SolutionResult execute(Instance& instance,
                                  const Tour& initialTour,
                                  int timeLimit = -1) = 0;
 
+  /**
+   * The settings of the programs executed by the benchmark, which
+   * read the time-expanded graph of the current instance from the
+   * graph cache rather than expanding it again.
+   **/
+  Program::Settings programSettings() const
+  {
+    return Program::Settings()
+      .collectStats()
+      .withGraphCache(graphCacheFile);
+  }
+
 public:
   void executeAll(const std::vector<InstanceInfo>& instanceInfos = InstanceInfo::smallInstances());
 
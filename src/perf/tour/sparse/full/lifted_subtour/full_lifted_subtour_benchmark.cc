@@ -15,7 +15,7 @@ SolutionResult FullLiftedSubtourBenchmark::execute(Instance& instance,
                         instance.timedDistances,
                         0,
                         false,
-                        Program::Settings().collectStats());
+                        programSettings());
 
   program.setPricer(new SparseTwoCycleFreePricer(program));
 
@@ -23,7 +23,7 @@ SolutionResult FullSparseProgramBenchmark::execute(Instance& instance,
                         instance.timedDistances,
                         0,
                         false,
-                        Program::Settings().collectStats());
+                        programSettings());
 
   program.setPricer(new SparseTwoCycleFreePricer(program));
 
@@ -5,8 +5,7 @@ SparsePricerBenchmark::execute(Instance& instance,
                                const Tour& initialTour,
                                int timeLimit)
 {
-  auto settings = Program::Settings()
-    .collectStats()
+  auto settings = programSettings()
     .withSetFile(setFilePath("sparse_pricer"));
 
   SparseProgram program(initialTour,
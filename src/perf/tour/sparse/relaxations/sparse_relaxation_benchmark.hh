@@ -26,7 +26,7 @@ SolutionResult SparseRelaxationBenchmark<Pricer>::execute(Instance& instance,
                         instance.timedDistances,
                         0.,
                         false,
-                        Program::Settings().collectStats().doSolveRelaxation());
+                        programSettings().doSolveRelaxation());
 
   program.setPricer(getPricer(program));
 
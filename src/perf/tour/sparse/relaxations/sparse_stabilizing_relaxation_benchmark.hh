@@ -27,7 +27,7 @@ SolutionResult SparseStabilizingRelaxationBenchmark<Pricer>::execute(Instance& i
                         instance.timedDistances,
                         0.,
                         false,
-                        Program::Settings().collectStats().doSolveRelaxation());
+                        programSettings().doSolveRelaxation());
 
   program.setPricer(getPricer(program));
 
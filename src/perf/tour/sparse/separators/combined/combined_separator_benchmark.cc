@@ -6,8 +6,7 @@ CombinedSeparatorBenchmark::execute(Instance& instance,
                                     const Tour& initialTour,
                                     int timeLimit)
 {
-  auto settings = Program::Settings()
-    .collectStats()
+  auto settings = programSettings()
     .withSetFile(setFilePath("sparse_combined_separators"));
 
   SparseProgram program(initialTour,
@@ -6,8 +6,7 @@ SparseSeparatorBenchmark::execute(Instance& instance,
                                   const Tour& initialTour,
                                   int timeLimit)
 {
-  auto settings = Program::Settings()
-    .collectStats()
+  auto settings = programSettings()
     .withSetFile(setFilePath("sparse_separator"));
 
   SparseProgram program(initialTour,
@@ -8,7 +8,7 @@ SolutionResult SimpleProgramBenchmark::execute(Instance& instance,
 {
   SimpleProgram program(initialTour,
                         instance.timedDistances,
-                        Program::Settings().collectStats());
+                        programSettings());
   return program.solve(timeLimit);
 }
 
@@ -0,0 +1,116 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "concurrent_cache.hh"
+
+TEST(ConcurrentCacheTest, testGet)
+{
+  idx computations = 0;
+
+  ConcurrentCache<idx, idx> cache([&](const idx& key) -> idx
+                                  {
+                                    ++computations;
+                                    return 2*key;
+                                  });
+
+  for(idx i = 0; i < 100; ++i)
+  {
+    ASSERT_EQ(2*i, cache.get(i));
+  }
+
+  for(idx i = 0; i < 100; ++i)
+  {
+    ASSERT_TRUE(cache.contains(i));
+    ASSERT_EQ(2*i, cache.get(i));
+  }
+
+  ASSERT_EQ(100, computations);
+  ASSERT_EQ(100, cache.getHits());
+  ASSERT_EQ(100, cache.getMisses());
+}
+
+TEST(ConcurrentCacheTest, testFind)
+{
+  ConcurrentCache<idx, idx> cache([](const idx& key) -> idx
+                                  {
+                                    return 2*key;
+                                  });
+
+  ASSERT_FALSE(cache.find(5).has_value());
+
+  cache.insert(5, 10);
+
+  ASSERT_EQ(10, cache.find(5).value());
+
+  ASSERT_EQ(1, cache.getHits());
+  ASSERT_EQ(1, cache.getMisses());
+}
+
+TEST(ConcurrentCacheTest, testEviction)
+{
+  const idx capacity = 64;
+
+  ConcurrentCache<idx, idx> cache([](const idx& key) -> idx
+                                  {
+                                    return key + 1;
+                                  },
+                                  capacity,
+                                  4);
+
+  for(idx i = 0; i < 10000; ++i)
+  {
+    ASSERT_EQ(i + 1, cache.get(i));
+    ASSERT_LE(cache.size(), capacity);
+  }
+
+  for(idx i = 0; i < 10000; ++i)
+  {
+    ASSERT_EQ(i + 1, cache.get(i));
+  }
+}
+
+TEST(ConcurrentCacheTest, testConcurrentGet)
+{
+  const idx numThreads = 8;
+  const idx numKeys = 1000;
+
+  std::atomic<idx> computations(0);
+
+  ConcurrentCache<idx, idx> cache([&](const idx& key) -> idx
+                                  {
+                                    ++computations;
+                                    return 3*key;
+                                  },
+                                  numKeys / 2);
+
+  std::atomic<bool> valid(true);
+  std::vector<std::thread> threads;
+
+  for(idx i = 0; i < numThreads; ++i)
+  {
+    threads.push_back(std::thread([&, i]()
+                                  {
+                                    for(idx j = 0; j < 10*numKeys; ++j)
+                                    {
+                                      const idx key = (j * (i + 1)) % numKeys;
+
+                                      if(cache.get(key) != 3*key)
+                                      {
+                                        valid = false;
+                                      }
+                                    }
+                                  }));
+  }
+
+  for(std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  ASSERT_TRUE(valid);
+  ASSERT_EQ(numThreads*10*numKeys, cache.getHits() + cache.getMisses());
+  ASSERT_EQ(computations, cache.getMisses());
+}
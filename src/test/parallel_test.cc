@@ -0,0 +1,85 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parallel.hh"
+
+TEST(ParallelTest, testThreadPool)
+{
+  ThreadPool pool(4);
+
+  ASSERT_EQ(4, pool.numThreads());
+
+  for(idx size = 0; size < 100; ++size)
+  {
+    std::vector<std::atomic<idx>> counts(size);
+
+    parallelFor(pool, size, [&](idx i) { ++counts[i]; });
+
+    for(idx i = 0; i < size; ++i)
+    {
+      ASSERT_EQ(1, counts[i]);
+    }
+  }
+}
+
+TEST(ParallelTest, testThreadIndex)
+{
+  ThreadPool pool(4);
+
+  ASSERT_EQ(0, pool.threadIndex());
+
+  std::vector<std::atomic<idx>> counts(pool.numThreads());
+
+  parallelFor(pool, 1000, [&](idx i) { ++counts.at(pool.threadIndex()); });
+
+  idx total = 0;
+
+  for(const std::atomic<idx>& count : counts)
+  {
+    total += count;
+  }
+
+  ASSERT_EQ(1000, total);
+}
+
+TEST(ParallelTest, testThreadPoolException)
+{
+  ThreadPool pool(4);
+
+  ASSERT_THROW(parallelFor(pool,
+                           100,
+                           [](idx i)
+                           {
+                             if(i == 50)
+                             {
+                               throw std::runtime_error("Failed");
+                             }
+                           }),
+               std::runtime_error);
+
+  std::atomic<idx> count(0);
+
+  parallelFor(pool, 100, [&](idx) { ++count; });
+
+  ASSERT_EQ(100, count);
+}
+
+TEST(ParallelTest, testFindFirst)
+{
+  ThreadPool pool(4);
+
+  for(idx first = 0; first <= 100; ++first)
+  {
+    const idx found = parallelFindFirst(pool,
+                                        100,
+                                        [&](idx i, const std::atomic<idx>&)
+                                        {
+                                          return i >= first;
+                                        });
+
+    ASSERT_EQ(first, found);
+  }
+}
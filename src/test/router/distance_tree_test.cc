@@ -132,3 +132,21 @@ TEST_F(DistanceTreeTest, testInitialDistance)
     ASSERT_EQ(distanceTree.distance(vertices[i]), 10 + i);
   }
 }
+
+TEST_F(DistanceTreeTest, testDecreasingRoot)
+{
+  auto costValues = costs.getValues();
+
+  DistanceTree<Direction::OUTGOING> distanceTree(graph, costValues, root);
+
+  distanceTree.extend(vertices[5]);
+
+  ASSERT_THROW(distanceTree.add(vertices[8], 2), std::invalid_argument);
+
+  distanceTree.add(vertices[8], 6);
+
+  distanceTree.extend();
+
+  ASSERT_EQ(distanceTree.distance(vertices[8]), 6);
+  ASSERT_EQ(distanceTree.distance(vertices[9]), 7);
+}
@@ -0,0 +1,90 @@
+#include <random>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "graph/edge_map.hh"
+
+#include "router/label.hh"
+#include "router/label_heap.hh"
+
+class LabelHeapTest : public testing::Test
+{
+protected:
+  Graph graph;
+  EdgeMap<num> costs;
+  std::mt19937 engine;
+
+public:
+  LabelHeapTest()
+    : graph(Graph::complete(50)),
+      costs(graph, 0),
+      engine(42)
+  {
+    auto distribution = std::uniform_int_distribution<>(0, 1000);
+
+    for(const Edge& edge : graph.getEdges())
+    {
+      costs(edge) = distribution(engine);
+    }
+  }
+
+  template <class Heap>
+  VertexMap<num> distances(Vertex source)
+  {
+    Heap heap(graph);
+    heap.update(SimpleLabel<>(source, 0));
+
+    num lastCost = 0;
+
+    while(!heap.isEmpty())
+    {
+      const SimpleLabel<>& current = heap.extractMin();
+
+      EXPECT_LE(lastCost, current.getCost());
+      lastCost = current.getCost();
+
+      for(const Edge& edge : graph.getOutgoing(current.getVertex()))
+      {
+        heap.update(SimpleLabel<>(edge.getTarget(), current.getCost() + costs(edge)));
+      }
+    }
+
+    VertexMap<num> result(graph, inf);
+
+    for(const Vertex& vertex : graph.getVertices())
+    {
+      result(vertex) = heap.getLabel(vertex).getCost();
+    }
+
+    return result;
+  }
+};
+
+TEST_F(LabelHeapTest, testRadixHeap)
+{
+  for(const Vertex& source : graph.getVertices())
+  {
+    VertexMap<num> expected = distances<LabelHeap<SimpleLabel<>>>(source);
+    VertexMap<num> actual = distances<RadixLabelHeap<SimpleLabel<>>>(source);
+
+    for(const Vertex& vertex : graph.getVertices())
+    {
+      ASSERT_EQ(expected(vertex), actual(vertex));
+    }
+  }
+}
+
+TEST_F(LabelHeapTest, testRadixHeapMonotonicity)
+{
+  std::vector<Vertex> vertices = graph.getVertices().collect();
+
+  RadixLabelHeap<SimpleLabel<>> heap(graph);
+
+  heap.update(SimpleLabel<>(vertices[0], 10));
+  heap.update(SimpleLabel<>(vertices[1], 20));
+
+  ASSERT_EQ(vertices[0], heap.extractMin().getVertex());
+
+  ASSERT_THROW(heap.update(SimpleLabel<>(vertices[2], 5)), std::invalid_argument);
+}
@@ -4,6 +4,7 @@
 #include "basic_test.hh"
 
 #include "timed/augmented_edge_func.hh"
+#include "timed/timed_router.hh"
 
 class AugmentedEdgeFuncTest : public BasicTest
 {
@@ -51,3 +52,39 @@ TEST_F(AugmentedEdgeFuncTest, testFunc)
   }
 
 }
+
+TEST_F(AugmentedEdgeFuncTest, testConcreteRouting)
+{
+  std::mt19937 engine(17);
+
+  const num timeSteps = 5000;
+  const idx scaleFactor = 3;
+
+  auto distribution = std::uniform_int_distribution<>(0, timeSteps);
+
+  auto func = AugmentedEdgeFunc::generate(graph,
+                                          costs,
+                                          scaleFactor,
+                                          10,
+                                          timeSteps,
+                                          [&]() -> idx {
+                                            return distribution(engine);
+                                          });
+
+  const TimedEdgeFunc<num>& virtualFunc = func;
+
+  TimedDijkstra router(graph);
+
+  for(idx i = 0; i < sources.size(); ++i)
+  {
+    for(idx departureTime = 0; departureTime < 100; departureTime += 10)
+    {
+      auto expected = router.shortestPath(sources[i], targets[i], virtualFunc, departureTime);
+      auto actual = router.shortestPath(sources[i], targets[i], func, departureTime);
+
+      ASSERT_TRUE(expected.found);
+      ASSERT_TRUE(actual.found);
+      ASSERT_EQ(expected.cost, actual.cost);
+    }
+  }
+}
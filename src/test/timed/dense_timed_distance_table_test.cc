@@ -0,0 +1,68 @@
+#include "timed/timed_test.hh"
+
+#include "timed/cached_tree_distances.hh"
+#include "timed/dense_timed_distance_table.hh"
+
+class DenseTimedDistanceTableTest : public TimedTest
+{
+protected:
+  const idx timeHorizon = 200;
+
+public:
+  DenseTimedDistanceTableTest()
+    : TimedTest(8)
+  {}
+};
+
+TEST_F(DenseTimedDistanceTableTest, testDistances)
+{
+  CachedTreeDistances expected(graph, vertices, timedCosts);
+
+  DenseTimedDistanceTable<> actual(graph, vertices, timedCosts, timeHorizon, 4);
+
+  DenseTimedDistanceTable<uint16_t> compactActual(graph, vertices, timedCosts, timeHorizon, 4);
+
+  for(idx departureTime = 0; departureTime < timeHorizon; ++departureTime)
+  {
+    for(const Vertex& source : vertices)
+    {
+      for(const Vertex& target : vertices)
+      {
+        const num expectedDistance = expected(source, target, departureTime);
+
+        ASSERT_EQ(expectedDistance, actual(source, target, departureTime));
+        ASSERT_EQ(expectedDistance, compactActual(source, target, departureTime));
+      }
+    }
+  }
+}
+
+TEST_F(DenseTimedDistanceTableTest, testBatchDistances)
+{
+  CachedTreeDistances cached(graph, vertices, timedCosts);
+
+  // searches are not shared with the cached distances
+  CachedTreeDistances expected(graph, vertices, timedCosts);
+
+  DenseTimedDistanceTable<> table(graph, vertices, timedCosts, timeHorizon, 4);
+
+  std::vector<num> cachedValues(vertices.size());
+  std::vector<num> tableValues(vertices.size());
+
+  for(idx departureTime = 0; departureTime < timeHorizon; departureTime += 7)
+  {
+    for(const Vertex& source : vertices)
+    {
+      cached.distances(source, departureTime, vertices, cachedValues);
+      table.distances(source, departureTime, vertices, tableValues);
+
+      for(idx i = 0; i < vertices.size(); ++i)
+      {
+        const num expectedDistance = expected(source, vertices[i], departureTime);
+
+        ASSERT_EQ(expectedDistance, cachedValues[i]);
+        ASSERT_EQ(expectedDistance, tableValues[i]);
+      }
+    }
+  }
+}
@@ -0,0 +1,153 @@
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "timed/piecewise_linear_func.hh"
+
+TEST(PiecewiseLinearFuncTest, testEmpty)
+{
+  PiecewiseLinearFunc func;
+
+  ASSERT_EQ(0, func.getHorizon());
+  ASSERT_TRUE(func.getBreakpoints().empty());
+}
+
+TEST(PiecewiseLinearFuncTest, testLinear)
+{
+  PiecewiseLinearFunc func;
+
+  for(num value = 10; value < 100; ++value)
+  {
+    func.push_back(value);
+  }
+
+  ASSERT_EQ(90, func.getHorizon());
+  ASSERT_EQ(1, func.getBreakpoints().size());
+
+  for(idx time = 0; time < func.getHorizon(); ++time)
+  {
+    ASSERT_EQ(10 + ((num) time), func(time));
+  }
+}
+
+TEST(PiecewiseLinearFuncTest, testValues)
+{
+  std::mt19937 engine(17);
+
+  auto slopes = std::uniform_int_distribution<>(-1, 1);
+  auto lengths = std::uniform_int_distribution<>(1, 20);
+
+  ValueVector values;
+  num value = 100;
+
+  for(idx piece = 0; piece < 100; ++piece)
+  {
+    const num slope = slopes(engine);
+    const num length = lengths(engine);
+
+    for(num i = 0; i < length; ++i)
+    {
+      values.push_back(value);
+      value += slope;
+    }
+  }
+
+  PiecewiseLinearFunc func;
+
+  for(const num& current : values)
+  {
+    func.push_back(current);
+  }
+
+  ASSERT_EQ(values.size(), func.getHorizon());
+  ASSERT_LE(func.getBreakpoints().size(), 100);
+
+  for(idx time = 0; time < values.size(); ++time)
+  {
+    ASSERT_EQ(values[time], func(time));
+  }
+}
+
+namespace
+{
+  PiecewiseLinearFunc randomFunc(std::mt19937& engine,
+                                 idx horizon,
+                                 num initialValue)
+  {
+    auto slopes = std::uniform_int_distribution<>(-1, 1);
+    auto lengths = std::uniform_int_distribution<>(1, 20);
+
+    PiecewiseLinearFunc func;
+    num value = initialValue;
+
+    while(func.getHorizon() < horizon)
+    {
+      const num slope = slopes(engine);
+      const idx length = std::min((idx) lengths(engine), horizon - func.getHorizon());
+
+      for(idx i = 0; i < length; ++i)
+      {
+        func.push_back(value);
+        value += slope;
+      }
+    }
+
+    return func;
+  }
+}
+
+TEST(PiecewiseLinearFuncTest, testMinimum)
+{
+  std::mt19937 engine(17);
+
+  const idx horizon = 1000;
+
+  PiecewiseLinearFunc first = randomFunc(engine, horizon, 100);
+  PiecewiseLinearFunc second = randomFunc(engine, horizon, 100);
+
+  bool improved;
+
+  PiecewiseLinearFunc minimum = PiecewiseLinearFunc::minimum(first, second, improved);
+
+  bool expectedImproved = false;
+
+  ASSERT_EQ(horizon, minimum.getHorizon());
+
+  for(idx time = 0; time < horizon; ++time)
+  {
+    ASSERT_EQ(std::min(first(time), second(time)), minimum(time));
+    expectedImproved = expectedImproved or (second(time) < first(time));
+  }
+
+  ASSERT_EQ(expectedImproved, improved);
+
+  PiecewiseLinearFunc::minimum(minimum, first, improved);
+
+  ASSERT_FALSE(improved);
+}
+
+TEST(PiecewiseLinearFuncTest, testLink)
+{
+  std::mt19937 engine(17);
+
+  const idx horizon = 1000;
+
+  PiecewiseLinearFunc travelTimes = randomFunc(engine, 2*horizon, 100);
+
+  PiecewiseLinearFunc departures;
+  departures.append(horizon, 0, 1);
+
+  PiecewiseLinearFunc arrivals = departures.link(travelTimes);
+  PiecewiseLinearFunc nextArrivals = arrivals.link(travelTimes);
+
+  ASSERT_EQ(horizon, arrivals.getHorizon());
+  ASSERT_EQ(horizon, nextArrivals.getHorizon());
+
+  for(idx time = 0; time < horizon; ++time)
+  {
+    const num arrival = time + travelTimes(time);
+
+    ASSERT_EQ(arrival, arrivals(time));
+    ASSERT_EQ(arrival + travelTimes(arrival), nextArrivals(time));
+  }
+}
@@ -0,0 +1,34 @@
+#include "timed/timed_test.hh"
+
+#include "timed/cached_tree_distances.hh"
+#include "timed/profile_distances.hh"
+
+class ProfileDistancesTest : public TimedTest
+{
+protected:
+  const idx timeHorizon = 500;
+
+public:
+  ProfileDistancesTest()
+    : TimedTest(10, 30)
+  {}
+};
+
+TEST_F(ProfileDistancesTest, testDistances)
+{
+  CachedTreeDistances expected(graph, vertices, timedCosts);
+
+  ProfileDistances actual(graph, vertices, timedCosts, timeHorizon);
+
+  for(const Vertex& source : vertices)
+  {
+    for(const Vertex& target : vertices)
+    {
+      for(idx departureTime = 0; departureTime < timeHorizon; ++departureTime)
+      {
+        ASSERT_EQ(expected(source, target, departureTime),
+                  actual(source, target, departureTime));
+      }
+    }
+  }
+}
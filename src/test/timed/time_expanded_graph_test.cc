@@ -1,3 +1,5 @@
+#include <cstdio>
+
 #include <gtest/gtest.h>
 
 #include "timed/time_expanded_graph.hh"
@@ -141,3 +143,125 @@ TEST_F(Fixture, getNonExistingVertex)
 {
   ASSERT_ANY_THROW({graph.getVertex(graph.underlyingVertex(source), 17, false);});
 }
+
+TEST_F(Fixture, testCompaction)
+{
+  graph.compact();
+
+  ASSERT_EQ(std::vector<TimedEdge>{edge}, graph.getOutgoing(source).collect());
+  ASSERT_EQ(std::vector<TimedEdge>{edge}, graph.getIncoming(target).collect());
+  ASSERT_EQ(std::vector<TimedEdge>{}, graph.getOutgoing(target).collect());
+  ASSERT_EQ(std::vector<TimedEdge>{}, graph.getIncoming(source).collect());
+
+  ASSERT_THROW(graph.addVertex(*vertices.begin(), 10), std::logic_error);
+}
+
+TEST(TimeExpandedGraphTest, testVertexLookup)
+{
+  Graph underlyingGraph(3, {});
+  std::vector<Vertex> vertices = underlyingGraph.getVertices().collect();
+
+  const idx timeHorizon = 20;
+
+  TimeExpandedGraph sparseGraph(underlyingGraph);
+  TimeExpandedGraph denseGraph(underlyingGraph, timeHorizon);
+
+  const std::vector<idx> times{17, 3, 25, 0, 8, 20};
+
+  for(TimeExpandedGraph* graph : {&sparseGraph, &denseGraph})
+  {
+    for(const idx& time : times)
+    {
+      graph->addVertex(vertices[1], time);
+    }
+
+    for(idx time = 0; time < 2*timeHorizon; ++time)
+    {
+      const bool expected = contains(times, time);
+
+      ASSERT_EQ(expected, graph->hasVertex(vertices[1], time));
+      ASSERT_FALSE(graph->hasVertex(vertices[0], time));
+
+      if(expected)
+      {
+        TimedVertex timedVertex = graph->getVertex(vertices[1], time);
+        ASSERT_EQ(time, timedVertex.getTime());
+        ASSERT_EQ(vertices[1], graph->underlyingVertex(timedVertex));
+      }
+    }
+
+    const std::vector<TimedVertex> expandedVertices = graph->getExpandedVertices(vertices[1]);
+
+    ASSERT_EQ(times.size(), expandedVertices.size());
+
+    for(idx i = 1; i < expandedVertices.size(); ++i)
+    {
+      ASSERT_LT(expandedVertices[i - 1].getTime(), expandedVertices[i].getTime());
+    }
+  }
+}
+
+TEST(TimeExpandedGraphTest, testSerialization)
+{
+  Graph underlyingGraph = Graph::complete(4);
+  std::vector<Vertex> vertices = underlyingGraph.getVertices().collect();
+
+  TimeExpandedGraph graph(underlyingGraph, 10);
+
+  std::vector<TimedVertex> timedVertices;
+
+  for(idx time = 0; time < 6; ++time)
+  {
+    timedVertices.push_back(graph.addVertex(vertices[time % vertices.size()], 2*time));
+  }
+
+  for(idx i = 1; i < timedVertices.size(); ++i)
+  {
+    const Vertex source = graph.underlyingVertex(timedVertices[i - 1]);
+    const Vertex target = graph.underlyingVertex(timedVertices[i]);
+
+    for(const Edge& underlyingEdge : underlyingGraph.getOutgoing(source))
+    {
+      if(underlyingEdge.getTarget() == target)
+      {
+        graph.addEdge(timedVertices[i - 1], timedVertices[i], underlyingEdge);
+      }
+    }
+  }
+
+  const std::string filename = testing::TempDir() + "time_expanded_graph.bin";
+
+  const uint64_t key = 42;
+
+  graph.write(filename, key);
+
+  TimeExpandedGraph readGraph = TimeExpandedGraph::read(underlyingGraph, filename, key);
+
+  ASSERT_TRUE(((const Graph&) readGraph).isCompact());
+  ASSERT_EQ(graph.getVertices().size(), readGraph.getVertices().size());
+  ASSERT_EQ(graph.getEdges().size(), readGraph.getEdges().size());
+
+  for(const TimedVertex& timedVertex : graph.getVertices())
+  {
+    TimedVertex readVertex = readGraph.getVertex(graph.underlyingVertex(timedVertex),
+                                                 timedVertex.getTime());
+
+    ASSERT_EQ(timedVertex.getIndex(), readVertex.getIndex());
+  }
+
+  for(const TimedEdge& timedEdge : graph.getEdges())
+  {
+    const Edge underlyingEdge = graph.underlyingEdge(timedEdge);
+
+    ASSERT_TRUE(readGraph.hasEdge(underlyingEdge, timedEdge.getSource().getTime()));
+    ASSERT_EQ(readGraph.getTimedEdges(underlyingEdge).size(),
+              graph.getTimedEdges(underlyingEdge).size());
+  }
+
+  Graph otherGraph = Graph::complete(5);
+
+  ASSERT_THROW(TimeExpandedGraph::read(otherGraph, filename, key), std::invalid_argument);
+  ASSERT_THROW(TimeExpandedGraph::read(underlyingGraph, filename, key + 1), std::invalid_argument);
+
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,32 @@
+#include "timed_test.hh"
+
+TimedTest::TimedTest(idx numVertices, num maxCost, idx timeSteps)
+  : timeSteps(timeSteps),
+    maxCost(maxCost),
+    graph(Graph::complete(numVertices)),
+    costs(graph, 0),
+    vertices(graph.getVertices().collect()),
+    engine(17),
+    timedCosts(generateTimedCosts())
+{}
+
+AugmentedEdgeFunc TimedTest::generateTimedCosts()
+{
+  auto costDistribution = std::uniform_int_distribution<>(1, maxCost);
+
+  for(const Edge& edge : graph.getEdges())
+  {
+    costs(edge) = costDistribution(engine);
+  }
+
+  auto timeDistribution = std::uniform_int_distribution<>(0, timeSteps);
+
+  return AugmentedEdgeFunc::generate(graph,
+                                     costs.getValues(),
+                                     3,
+                                     100,
+                                     timeSteps,
+                                     [&]() -> idx {
+                                       return timeDistribution(engine);
+                                     });
+}
@@ -0,0 +1,39 @@
+#ifndef TIMED_TEST_HH
+#define TIMED_TEST_HH
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "graph/graph.hh"
+#include "graph/edge_map.hh"
+
+#include "timed/augmented_edge_func.hh"
+
+/**
+ * A complete graph with random costs between one and the given
+ * maximum cost and time-dependent costs generated from them.
+ **/
+class TimedTest : public testing::Test
+{
+protected:
+  const idx timeSteps;
+  const num maxCost;
+
+  Graph graph;
+  EdgeMap<num> costs;
+  std::vector<Vertex> vertices;
+  std::mt19937 engine;
+  AugmentedEdgeFunc timedCosts;
+
+private:
+  AugmentedEdgeFunc generateTimedCosts();
+
+public:
+  TimedTest(idx numVertices = 10,
+            num maxCost = 20,
+            idx timeSteps = 1000);
+};
+
+#endif /* TIMED_TEST_HH */
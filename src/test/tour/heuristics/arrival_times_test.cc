@@ -0,0 +1,74 @@
+#include <algorithm>
+
+#include "timed/timed_test.hh"
+
+#include "timed/cached_tree_distances.hh"
+
+#include "tour/heuristics/arrival_times.hh"
+
+class ArrivalTimesTest : public TimedTest
+{
+};
+
+TEST_F(ArrivalTimesTest, testEvaluation)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  TimedDistanceEvaluator evaluator(distances);
+
+  const idx size = vertices.size();
+
+  std::vector<Vertex> tourVertices = vertices;
+  std::shuffle(std::begin(tourVertices), std::end(tourVertices), engine);
+
+  ArrivalTimes<> arrivalTimes(evaluator, tourVertices);
+
+  const num currentCost = evaluator(Tour(graph, tourVertices));
+
+  ASSERT_EQ(currentCost, arrivalTimes.cost());
+
+  auto positionDistribution = std::uniform_int_distribution<idx>(0, size);
+
+  std::vector<std::pair<idx, idx>> ranges{{0, size}, {0, 1}, {0, 3}, {size - 3, size}, {2, 2}};
+
+  for(idx i = 0; i < 200; ++i)
+  {
+    idx begin = positionDistribution(engine);
+    idx end = positionDistribution(engine);
+
+    ranges.push_back({std::min(begin, end), std::max(begin, end)});
+  }
+
+  for(const auto& [begin, end] : ranges)
+  {
+    std::vector<Vertex> replacement(tourVertices.begin() + begin,
+                                    tourVertices.begin() + end);
+
+    std::shuffle(std::begin(replacement), std::end(replacement), engine);
+
+    std::vector<Vertex> nextVertices = tourVertices;
+    std::copy(std::begin(replacement), std::end(replacement), nextVertices.begin() + begin);
+
+    const num expected = evaluator(Tour(graph, nextVertices));
+
+    ASSERT_EQ(expected, arrivalTimes.evaluate(begin,
+                                              end,
+                                              std::begin(replacement),
+                                              std::end(replacement)));
+
+    // Augmented edge functions satisfy the FIFO property
+    const num fifoCost = arrivalTimes.evaluateFIFO(begin,
+                                                   end,
+                                                   std::begin(replacement),
+                                                   std::end(replacement));
+
+    if(expected < currentCost)
+    {
+      ASSERT_EQ(expected, fifoCost);
+    }
+    else
+    {
+      ASSERT_GE(fifoCost, currentCost);
+    }
+  }
+}
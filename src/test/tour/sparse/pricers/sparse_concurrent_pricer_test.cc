@@ -0,0 +1,101 @@
+#include <random>
+
+#include "sparse_pricer_test.hh"
+
+#include "tour/sparse/pricers/sparse_concurrent_pricer.hh"
+#include "tour/sparse/pricers/sparse_edge_pricer.hh"
+#include "tour/sparse/pricers/sparse_path_router_pricer.hh"
+
+class SparseConcurrentPricerTest : public SparsePricerTest
+{
+protected:
+  virtual SparsePricer* getPricer(SparseProgram& program,
+                                  const Instance& instance) override;
+
+  std::vector<std::unique_ptr<SparsePricer>> createPricers(SparseProgram& program);
+};
+
+SparsePricer* SparseConcurrentPricerTest::getPricer(SparseProgram& program,
+                                                    const Instance& instance)
+{
+  return SparseConcurrentPricer::createDefault(program).release();
+}
+
+std::vector<std::unique_ptr<SparsePricer>>
+SparseConcurrentPricerTest::createPricers(SparseProgram& program)
+{
+  std::vector<std::unique_ptr<SparsePricer>> pricers;
+
+  pricers.push_back(std::make_unique<SparseEdgePricer>(program));
+  pricers.push_back(std::make_unique<SparseSimplePathPricer>(program));
+  pricers.push_back(std::make_unique<SparseAcyclicHoleFreePricer<3>>(program));
+
+  return pricers;
+}
+
+TEST_F(SparseConcurrentPricerTest, testSparseConcurrentPricer)
+{
+  testPricer();
+}
+
+TEST_F(SparseConcurrentPricerTest, testMergedResult)
+{
+  Instance instance(infos.front());
+
+  TourSolver simpleSolver(instance.graph, instance.staticCosts);
+
+  Tour initialTour = simpleSolver.findTour();
+
+  SparseProgram program(initialTour,
+                        instance.timedDistances,
+                        0,
+                        false);
+
+  const TimeExpandedGraph& graph = program.getGraph();
+
+  std::mt19937 engine(17);
+  std::uniform_real_distribution<> distribution(0., 2.);
+
+  EdgeMap<double> dualValues(graph, 0.);
+  EdgeMap<double> reducedCosts(graph, 0.);
+  VertexMap<double> coveringDuals(instance.graph, 0.);
+
+  for(const TimedEdge& timedEdge : graph.getEdges())
+  {
+    dualValues(timedEdge) = distribution(engine) * timedEdge.travelTime();
+    reducedCosts(timedEdge) = timedEdge.travelTime() - dualValues(timedEdge);
+  }
+
+  for(const Vertex& vertex : instance.graph.getVertices())
+  {
+    coveringDuals(vertex) = distribution(engine);
+  }
+
+  const DualSnapshot snapshot(DualCostType::SIMPLE,
+                              std::move(dualValues),
+                              std::move(reducedCosts),
+                              EdgeMap<double>(graph, 0.),
+                              std::move(coveringDuals),
+                              EdgeSet(instance.graph),
+                              0.,
+                              0.,
+                              program.getTimeHorizon());
+
+  std::vector<SparsePricingResult> serialResults;
+
+  for(std::unique_ptr<SparsePricer>& pricer : createPricers(program))
+  {
+    serialResults.push_back(pricer->performPricing(snapshot));
+  }
+
+  const SparsePricingResult expected = SparseConcurrentPricer::merge(graph, serialResults);
+
+  SparseConcurrentPricer concurrentPricer(program, createPricers(program), 3);
+
+  const SparsePricingResult actual = concurrentPricer.performPricing(snapshot);
+
+  ASSERT_FALSE(expected.isEmpty());
+  ASSERT_EQ(expected.getPaths(), actual.getPaths());
+  ASSERT_EQ(expected.getEdges(), actual.getEdges());
+  ASSERT_EQ(expected.getLowerBound(), actual.getLowerBound());
+}
@@ -0,0 +1,61 @@
+#include <limits>
+
+#include "timed/timed_test.hh"
+
+#include "timed/cached_tree_distances.hh"
+
+#include "tour/timed/heuristics/multi_start_lkh_solver.hh"
+
+class MultiStartLKHSolverTest : public TimedTest
+{
+protected:
+  const double timeLimit = std::numeric_limits<double>::infinity();
+  const idx maxRuns = 20;
+};
+
+TEST_F(MultiStartLKHSolverTest, testReproducible)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  const Tour initialTour(graph, vertices);
+
+  MultiStartLKHSolver solver(graph,
+                             vertices,
+                             distances,
+                             TimedLKHSolver::simpleDistances(distances));
+
+  const Tour tour = solver.findTour(initialTour, timeLimit, maxRuns, 5);
+  const Tour otherTour = solver.findTour(initialTour, timeLimit, maxRuns, 5);
+
+  ASSERT_EQ(tour.getVertices(), otherTour.getVertices());
+
+  ASSERT_TRUE(tour.connects(vertices));
+  ASSERT_EQ(tour.getSource(), initialTour.getSource());
+}
+
+TEST_F(MultiStartLKHSolverTest, testImprovement)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  const Tour initialTour(graph, vertices);
+
+  TimedLKHSolver lkhSolver(graph,
+                           vertices,
+                           distances,
+                           TimedLKHSolver::simpleDistances(distances));
+
+  MultiStartLKHSolver solver(graph,
+                             vertices,
+                             distances,
+                             TimedLKHSolver::simpleDistances(distances));
+
+  const Tour improvedTour = lkhSolver.improveTour(initialTour);
+
+  for(idx seed = 0; seed < 5; ++seed)
+  {
+    const Tour tour = solver.findTour(initialTour, timeLimit, maxRuns, seed);
+
+    ASSERT_TRUE(tour.connects(vertices));
+    ASSERT_LE(tour.cost(distances), improvedTour.cost(distances));
+  }
+}
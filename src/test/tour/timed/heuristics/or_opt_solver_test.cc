@@ -0,0 +1,30 @@
+#include "timed/timed_test.hh"
+
+#include "timed/cached_tree_distances.hh"
+
+#include "tour/timed/heuristics/or_opt_solver.hh"
+
+class OrOptSolverTest : public TimedTest
+{
+};
+
+TEST_F(OrOptSolverTest, testFIFO)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  const Tour initialTour(graph, vertices);
+
+  OrOptSolver solver(graph, distances, 3, false);
+
+  // Augmented edge functions satisfy the FIFO property
+  OrOptSolver fifoSolver(graph, distances, 3, true);
+
+  const Tour tour = solver.findTour(initialTour);
+  const Tour fifoTour = fifoSolver.findTour(initialTour);
+
+  ASSERT_EQ(tour.getVertices(), fifoTour.getVertices());
+
+  ASSERT_TRUE(tour.connects(vertices));
+  ASSERT_EQ(tour.getSource(), initialTour.getSource());
+  ASSERT_LE(tour.cost(distances), initialTour.cost(distances));
+}
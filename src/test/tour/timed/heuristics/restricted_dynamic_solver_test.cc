@@ -0,0 +1,58 @@
+#include <stdexcept>
+
+#include "timed/timed_test.hh"
+
+#include "timed/cached_tree_distances.hh"
+
+#include "tour/timed/heuristics/restricted_dynamic_solver.hh"
+
+class RestrictedDynamicSolverTest : public TimedTest
+{
+};
+
+TEST_F(RestrictedDynamicSolverTest, testThreads)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  RestrictedDynamicSolver sequentialSolver(graph, vertices, 10, 1);
+  RestrictedDynamicSolver parallelSolver(graph, vertices, 10, 8);
+
+  const Tour sequentialTour = sequentialSolver.findTour(distances);
+  const Tour parallelTour = parallelSolver.findTour(distances);
+
+  ASSERT_TRUE(sequentialTour.connects(vertices));
+  ASSERT_EQ(sequentialTour.getVertices(), parallelTour.getVertices());
+}
+
+TEST_F(RestrictedDynamicSolverTest, testTooManyVertices)
+{
+  const Graph largeGraph = Graph::complete(1025);
+  const std::vector<Vertex> largeVertices = largeGraph.getVertices().collect();
+
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  RestrictedDynamicSolver solver(largeGraph, largeVertices);
+
+  EXPECT_THROW(solver.findTour(distances), std::invalid_argument);
+}
+
+class RestrictedDynamicSolverLargeTest : public TimedTest
+{
+public:
+  // More than 64 vertices, requiring sets of two words
+  RestrictedDynamicSolverLargeTest()
+    : TimedTest(90)
+  {}
+};
+
+TEST_F(RestrictedDynamicSolverLargeTest, testTour)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  RestrictedDynamicSolver solver(graph, vertices);
+
+  const Tour tour = solver.findTour(distances);
+
+  ASSERT_EQ(tour.getVertices().size(), vertices.size());
+  ASSERT_TRUE(tour.connects(vertices));
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+
+#include "timed/timed_test.hh"
+
+#include "timed/cached_tree_distances.hh"
+
+#include "tour/timed/heuristics/timed_candidate_lists.hh"
+
+class TimedCandidateListsTest : public TimedTest
+{
+protected:
+  const idx timeHorizon = 200;
+  const idx numWindows = 8;
+  const idx numCandidates = 4;
+};
+
+TEST_F(TimedCandidateListsTest, testCandidates)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  TimedCandidateLists candidateLists(graph,
+                                     vertices,
+                                     distances,
+                                     timeHorizon,
+                                     numWindows,
+                                     numCandidates,
+                                     4);
+
+  const idx windowLength = timeHorizon / numWindows;
+
+  for(idx departureTime = 0; departureTime < 2*timeHorizon; departureTime += 7)
+  {
+    const idx windowStart = std::min(departureTime / windowLength,
+                                     numWindows - 1) * windowLength;
+
+    for(const Vertex& source : vertices)
+    {
+      const std::vector<Vertex>& candidates = candidateLists(source, departureTime);
+
+      ASSERT_EQ(candidates.size(), numCandidates);
+
+      num lastDistance = 0;
+
+      for(const Vertex& candidate : candidates)
+      {
+        ASSERT_NE(candidate, source);
+
+        const num distance = distances(source, candidate, windowStart);
+
+        ASSERT_LE(lastDistance, distance);
+
+        lastDistance = distance;
+      }
+
+      // No other vertex is closer than the last candidate
+      for(const Vertex& vertex : vertices)
+      {
+        if(vertex == source or
+           std::find(std::begin(candidates), std::end(candidates), vertex) != std::end(candidates))
+        {
+          continue;
+        }
+
+        ASSERT_GE(distances(source, vertex, windowStart), lastDistance);
+      }
+    }
+  }
+}
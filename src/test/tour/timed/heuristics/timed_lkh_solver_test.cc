@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <memory>
+
+#include "timed/timed_test.hh"
+
+#include "timed/cached_tree_distances.hh"
+
+#include "tour/timed/heuristics/timed_lkh_solver.hh"
+
+/**
+ * A straightforward version of the search of the TimedLKHSolver
+ * (using the same parameters), which copies the tour at every node
+ * and evaluates it in full.
+ **/
+class ReferenceLKHSolver
+{
+private:
+  const Graph& graph;
+  TimedDistanceFunc& distances;
+  TimedLKHSolver::ScoreFunction scoreFunction;
+  std::shared_ptr<const TimedCandidateLists> candidateLists;
+
+  const idx backTracingSteps = 5;
+  const idx maxCandidates = 5;
+
+  num bestCost;
+  std::vector<Vertex> bestVertices;
+
+  std::vector<Vertex> getCandidates(const std::vector<Vertex>& tourVertices,
+                                    idx headSize,
+                                    num currentTime,
+                                    num arrivalTime) const
+  {
+    const Vertex currentVertex = tourVertices[headSize - 1];
+    const Vertex nextVertex = tourVertices[headSize];
+
+    const num nextScore = scoreFunction(currentVertex, nextVertex, nextVertex, currentTime);
+
+    std::vector<Vertex> tail(tourVertices.begin() + headSize + 1, tourVertices.end());
+
+    if(candidateLists)
+    {
+      std::vector<Vertex> listed;
+
+      for(const Vertex& candidate : (*candidateLists)(currentVertex, arrivalTime))
+      {
+        if(std::find(tail.begin(), tail.end(), candidate) != tail.end())
+        {
+          listed.push_back(candidate);
+        }
+      }
+
+      tail = listed;
+    }
+
+    std::vector<std::pair<double, Vertex>> scoredCandidates;
+
+    for(const Vertex& candidate : tail)
+    {
+      const double score = scoreFunction(currentVertex, nextVertex, candidate, currentTime);
+
+      if((num) score < nextScore)
+      {
+        scoredCandidates.push_back(std::make_pair(score, candidate));
+      }
+    }
+
+    std::sort(scoredCandidates.begin(), scoredCandidates.end(),
+              [&](const std::pair<double, Vertex>& first,
+                  const std::pair<double, Vertex>& second) -> bool
+              {
+                return first.first < second.first;
+              });
+
+    std::vector<Vertex> candidates;
+
+    for(idx i = 0; i < std::min((idx) scoredCandidates.size(), maxCandidates); ++i)
+    {
+      candidates.push_back(scoredCandidates[i].second);
+    }
+
+    return candidates;
+  }
+
+  void search(const std::vector<Vertex>& tourVertices,
+              idx headSize,
+              num currentTime,
+              idx steps)
+  {
+    num arrivalTime = 0;
+
+    for(idx i = 1; i < headSize; ++i)
+    {
+      arrivalTime += distances(tourVertices[i - 1], tourVertices[i], arrivalTime);
+    }
+
+    if(arrivalTime >= bestCost)
+    {
+      return;
+    }
+
+    const num cost = Tour(graph, tourVertices).cost(distances);
+
+    if(cost < bestCost)
+    {
+      bestCost = cost;
+      bestVertices = tourVertices;
+    }
+
+    if(headSize == tourVertices.size())
+    {
+      return;
+    }
+
+    const std::vector<Vertex> candidates = getCandidates(tourVertices,
+                                                         headSize,
+                                                         currentTime,
+                                                         arrivalTime);
+
+    const bool forced = candidates.empty();
+
+    const idx numChildren = (forced or steps >= backTracingSteps) ? 1 : candidates.size();
+
+    for(idx child = 0; child < numChildren; ++child)
+    {
+      const Vertex currentVertex = tourVertices[headSize - 1];
+      const Vertex nextVertex = forced ? tourVertices[headSize] : candidates[child];
+
+      std::vector<Vertex> nextVertices = tourVertices;
+
+      auto position = std::find(nextVertices.begin(), nextVertices.end(), nextVertex);
+
+      std::reverse(nextVertices.begin() + headSize, position + 1);
+
+      search(nextVertices,
+             headSize + 1,
+             currentTime + distances(currentVertex, nextVertex, currentTime),
+             forced ? steps : steps + 1);
+    }
+  }
+
+public:
+  ReferenceLKHSolver(const Graph& graph,
+                     TimedDistanceFunc& distances,
+                     TimedLKHSolver::ScoreFunction scoreFunction,
+                     std::shared_ptr<const TimedCandidateLists> candidateLists = nullptr)
+    : graph(graph),
+      distances(distances),
+      scoreFunction(scoreFunction),
+      candidateLists(candidateLists)
+  {}
+
+  Tour improveTour(const Tour& initialTour)
+  {
+    bestCost = initialTour.cost(distances);
+    bestVertices = initialTour.getVertices();
+
+    for(idx headSize = 1; headSize < bestVertices.size(); ++headSize)
+    {
+      search(initialTour.getVertices(), headSize, 0, 0);
+    }
+
+    return Tour(graph, bestVertices);
+  }
+};
+
+class TimedLKHSolverTest : public TimedTest
+{
+protected:
+  const idx timeHorizon = 400;
+  const idx numWindows = 8;
+
+  void testReference(std::shared_ptr<const TimedCandidateLists> candidateLists = nullptr);
+};
+
+void TimedLKHSolverTest::testReference(std::shared_ptr<const TimedCandidateLists> candidateLists)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  const std::vector<TimedLKHSolver::ScoreFunction> scoreFunctions{
+    TimedLKHSolver::simpleDistances(distances),
+    TimedLKHSolver::comparedDistances(distances)};
+
+  for(const TimedLKHSolver::ScoreFunction& scoreFunction : scoreFunctions)
+  {
+    TimedLKHSolver solver(graph, vertices, distances, scoreFunction, candidateLists);
+
+    ReferenceLKHSolver referenceSolver(graph, distances, scoreFunction, candidateLists);
+
+    std::vector<Vertex> tourVertices = vertices;
+    idx numImproved = 0;
+
+    for(idx i = 0; i < 5; ++i)
+    {
+      std::shuffle(std::begin(tourVertices), std::end(tourVertices), engine);
+
+      const Tour initialTour(graph, tourVertices);
+
+      const Tour expected = referenceSolver.improveTour(initialTour);
+      const Tour actual = solver.improveTour(initialTour);
+
+      ASSERT_EQ(expected.getVertices(), actual.getVertices());
+      ASSERT_EQ(expected.cost(distances), actual.cost(distances));
+
+      if(actual.cost(distances) < initialTour.cost(distances))
+      {
+        ++numImproved;
+      }
+    }
+
+    ASSERT_GT(numImproved, 0);
+  }
+}
+
+TEST_F(TimedLKHSolverTest, testCompleteCandidateLists)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  const Tour initialTour(graph, vertices);
+
+  // Lists containing all other vertices do not restrict the search
+  auto candidateLists = std::make_shared<const TimedCandidateLists>(graph,
+                                                                    vertices,
+                                                                    distances,
+                                                                    timeHorizon,
+                                                                    numWindows,
+                                                                    vertices.size() - 1);
+
+  TimedLKHSolver solver(graph,
+                        vertices,
+                        distances,
+                        TimedLKHSolver::simpleDistances(distances));
+
+  TimedLKHSolver listSolver(graph,
+                            vertices,
+                            distances,
+                            TimedLKHSolver::simpleDistances(distances),
+                            candidateLists);
+
+  const Tour tour = solver.improveTour(initialTour);
+  const Tour listTour = listSolver.improveTour(initialTour);
+
+  ASSERT_EQ(tour.cost(distances), listTour.cost(distances));
+}
+
+TEST_F(TimedLKHSolverTest, testCandidateLists)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  const Tour initialTour(graph, vertices);
+
+  auto candidateLists = std::make_shared<const TimedCandidateLists>(graph,
+                                                                    vertices,
+                                                                    distances,
+                                                                    timeHorizon,
+                                                                    numWindows,
+                                                                    4);
+
+  TimedLKHSolver solver(graph,
+                        vertices,
+                        distances,
+                        TimedLKHSolver::simpleDistances(distances),
+                        candidateLists);
+
+  const Tour tour = solver.improveTour(initialTour);
+
+  ASSERT_TRUE(tour.connects(vertices));
+  ASSERT_EQ(tour.getSource(), initialTour.getSource());
+  ASSERT_LT(tour.cost(distances), initialTour.cost(distances));
+}
+
+TEST_F(TimedLKHSolverTest, testReference)
+{
+  testReference();
+}
+
+TEST_F(TimedLKHSolverTest, testReferenceCandidateLists)
+{
+  CachedTreeDistances distances(graph, vertices, timedCosts);
+
+  testReference(std::make_shared<const TimedCandidateLists>(graph,
+                                                             vertices,
+                                                             distances,
+                                                             timeHorizon,
+                                                             numWindows,
+                                                             4));
+}